@@ -11,6 +11,8 @@
 #include <vector>
 
 #include "base/command_line.h"
+#include "base/files/file_util.h"
+#include "base/logging.h"
 #include "lua_yue/binding_signal.h"
 #include "lua_yue/binding_values.h"
 #include "nativeui/nativeui.h"
@@ -32,6 +34,20 @@ struct Type<base::FilePath> {
   }
 };
 
+template<>
+struct Type<nu::Buffer> {
+  static constexpr const char* name = "yue.Buffer";
+  static inline bool To(State* state, int index, nu::Buffer* out) {
+    // Binary data is passed as string, which is used without copying.
+    if (GetType(state, index) != LuaType::String)
+      return false;
+    size_t size = 0;
+    const char* content = lua_tolstring(state, index, &size);
+    *out = nu::Buffer(content, size);
+    return true;
+  }
+};
+
 template<>
 struct Type<nu::Size> {
   static constexpr const char* name = "yue.Size";
@@ -172,7 +188,87 @@ struct Type<nu::MessageLoop> {
            "run", &nu::MessageLoop::Run,
            "quit", &nu::MessageLoop::Quit,
            "posttask", &nu::MessageLoop::PostTask,
-           "postdelayedtask", &nu::MessageLoop::PostDelayedTask);
+           "postdelayedtask", &nu::MessageLoop::PostDelayedTask,
+           "canceldelayedtask", &nu::MessageLoop::CancelDelayedTask,
+           "resetdelayedtask", &nu::MessageLoop::ResetDelayedTask,
+           "requestframe", &nu::MessageLoop::RequestFrame);
+  }
+};
+
+// Create a |reply| that passes the result of an asynchronous operation to
+// the function at |callback|. Without a callback the reply resumes the
+// calling coroutine with the result, |yield| is then set and the caller must
+// return lua_yield(state, 0) after releasing all C++ objects. Returns false
+// with error pushed on stack when neither is possible.
+template<typename R>
+bool GetAsyncReply(State* state, int callback,
+                   std::function<void(R)>* reply, bool* yield) {
+  // Keep references in the main thread, which outlives the coroutine.
+  lua_rawgeti(state, LUA_REGISTRYINDEX, LUA_RIDX_MAINTHREAD);
+  State* main = lua_tothread(state, -1);
+  PopAndIgnore(state, 1);
+  *yield = false;
+  if (GetType(state, callback) == LuaType::Function) {
+    lua_pushvalue(state, callback);
+    lua_xmove(state, main, 1);
+    To(main, -1, reply);
+    PopAndIgnore(main, 1);
+    return true;
+  }
+  if (!lua_isyieldable(state)) {
+    Push(state, "a callback is required when not called in a coroutine");
+    return false;
+  }
+  lua_pushthread(state);
+  lua_xmove(state, main, 1);
+  auto thread_ref = std::make_shared<Persistent>(main);
+  *reply = [state, main, thread_ref](R result) {
+    Push(state, result);
+    int status = lua_resume(state, main, 1);
+    if (status != LUA_OK && status != LUA_YIELD) {
+      std::string error;
+      lua::To(state, -1, &error);
+      LOG(ERROR) << "Error when resuming lua coroutine: " << error;
+    }
+    SetTop(state, 0);
+  };
+  *yield = true;
+  return true;
+}
+
+template<>
+struct Type<nu::ThreadPool> {
+  static constexpr const char* name = "yue.ThreadPool";
+  static void BuildMetaTable(State* state, int index) {
+    RawSet(state, index,
+           "setworkercount", &nu::ThreadPool::SetWorkerCount,
+           "getworkercount", &nu::ThreadPool::GetWorkerCount,
+           "readfile", CFunction(&ReadFile));
+  }
+  static int ReadFile(State* state) {
+    bool success, yield = false;
+    {
+      base::FilePath path;
+      std::function<void(base::Value)> reply;
+      success = To(state, 1, &path);
+      if (!success)
+        Push(state, "the arg 1 should be a file path");
+      else
+        success = GetAsyncReply(state, 2, &reply, &yield);
+      if (success) {
+        nu::ThreadPool::PostTaskAndReplyWithResult<base::Value>([path]() {
+          std::string content;
+          if (!base::ReadFileToString(path, &content))
+            return base::Value();
+          return base::Value(std::vector<char>(content.begin(),
+                                               content.end()));
+        }, reply);
+      }
+    }
+    // Throw error or yield after we are out of C++ stack.
+    if (!success)
+      return lua_error(state);
+    return yield ? lua_yield(state, 0) : 0;
   }
 };
 
@@ -309,19 +405,93 @@ struct Type<nu::Font> {
   static constexpr const char* name = "yue.Font";
   static void BuildMetaTable(State* state, int index) {
     RawSet(state, index,
-           "create", &CreateOnHeap<nu::Font, const std::string&, float,
-                                   nu::Font::Weight, nu::Font::Style>,
+           "create", &Create,
            "default", &GetDefault,
            "getname", &nu::Font::GetName,
            "getsize", &nu::Font::GetSize,
            "getweight", &nu::Font::GetWeight,
            "getstyle", &nu::Font::GetStyle);
   }
+  // Fonts are interned, equal requests get the same object.
+  static void Create(CallContext* context, const std::string& name,
+                     float size, nu::Font::Weight weight,
+                     nu::Font::Style style) {
+    scoped_refptr<nu::Font> font = nu::Font::Get(name, size, weight, style);
+    Push(context->state, font.get());
+    context->return_values_count = 1;
+  }
   static nu::Font* GetDefault() {
     return nu::App::GetCurrent()->GetDefaultFont();
   }
 };
 
+template<>
+struct Type<nu::Canvas::Pixels::Format> {
+  static constexpr const char* name = "yue.Canvas.Pixels.Format";
+  static inline void Push(State* state, nu::Canvas::Pixels::Format format) {
+    if (format == nu::Canvas::Pixels::Format::PremultipliedARGB)
+      lua::Push(state, "premultiplied-argb");
+    else
+      lua::Push(state, "argb");
+  }
+};
+
+// The userdata passed to the lockpixels callback, which reads and writes the
+// locked pixels in place. Pixels are 32-bit integers indexed from 1 in row
+// order, and the width, height, stride and format fields are also readable.
+struct PixelBuffer {
+  nu::Canvas::Pixels pixels;
+  bool valid;
+};
+
+uint32_t* GetPixel(State* state, PixelBuffer* buffer, int index) {
+  if (!buffer->valid)
+    luaL_error(state, "pixels are only accessible in lockpixels callback");
+  const nu::Canvas::Pixels& pixels = buffer->pixels;
+  if (index < 1 || index > pixels.width * pixels.height)
+    luaL_error(state, "pixel index out of range");
+  int row = (index - 1) / pixels.width;
+  int column = (index - 1) % pixels.width;
+  return reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(pixels.data) +
+                                     row * pixels.stride) + column;
+}
+
+int PixelBufferIndex(State* state) {
+  auto* buffer = static_cast<PixelBuffer*>(lua_touserdata(state, 1));
+  if (GetType(state, 2) == LuaType::Number) {
+    lua_pushinteger(state, *GetPixel(state, buffer,
+                                     static_cast<int>(lua_tointeger(state, 2))));
+    return 1;
+  }
+  std::string key;
+  if (!To(state, 2, &key))
+    return 0;
+  if (key == "width")
+    Push(state, buffer->pixels.width);
+  else if (key == "height")
+    Push(state, buffer->pixels.height);
+  else if (key == "stride")
+    Push(state, buffer->pixels.stride);
+  else if (key == "format")
+    Push(state, buffer->pixels.format);
+  else
+    return 0;
+  return 1;
+}
+
+int PixelBufferNewIndex(State* state) {
+  auto* buffer = static_cast<PixelBuffer*>(lua_touserdata(state, 1));
+  *GetPixel(state, buffer, static_cast<int>(luaL_checkinteger(state, 2))) =
+      static_cast<uint32_t>(luaL_checkinteger(state, 3));
+  return 0;
+}
+
+int PixelBufferLength(State* state) {
+  auto* buffer = static_cast<PixelBuffer*>(lua_touserdata(state, 1));
+  Push(state, buffer->pixels.width * buffer->pixels.height);
+  return 1;
+}
+
 template<>
 struct Type<nu::Canvas> {
   static constexpr const char* name = "yue.Canvas";
@@ -331,7 +501,37 @@ struct Type<nu::Canvas> {
            "createformainscreen", &CreateOnHeap<nu::Canvas, const nu::SizeF&>,
            "getscalefactor", &nu::Canvas::GetScaleFactor,
            "getpainter", &nu::Canvas::GetPainter,
-           "getsize", &nu::Canvas::GetSize);
+           "getsize", &nu::Canvas::GetSize,
+           "lockpixels", CFunction(&LockPixels));
+  }
+  static int LockPixels(State* state) {
+    nu::Canvas* canvas;
+    if (!To(state, 1, &canvas) || GetType(state, 2) != LuaType::Function) {
+      Push(state, "lockpixels requires a function");
+      return lua_error(state);
+    }
+    nu::Canvas::Pixels pixels;
+    if (!canvas->LockPixels(&pixels)) {
+      Push(state, "failed to lock pixels");
+      return lua_error(state);
+    }
+    lua_pushvalue(state, 2);
+    auto* buffer =
+        static_cast<PixelBuffer*>(lua_newuserdata(state, sizeof(PixelBuffer)));
+    buffer->pixels = pixels;
+    buffer->valid = true;
+    if (luaL_newmetatable(state, "yue.PixelBuffer")) {
+      RawSet(state, -1,
+             "__index", CFunction(&PixelBufferIndex),
+             "__newindex", CFunction(&PixelBufferNewIndex),
+             "__len", CFunction(&PixelBufferLength));
+    }
+    SetMetaTable(state, -2);
+    // The buffer may be kept by the callback, so invalidate it after call.
+    bool success = lua_pcall(state, 1, 0, 0) == LUA_OK;
+    buffer->valid = false;
+    canvas->UnlockPixels();
+    return success ? 0 : lua_error(state);
   }
 };
 
@@ -370,10 +570,142 @@ struct Type<nu::Image> {
   static constexpr const char* name = "yue.Image";
   static void BuildMetaTable(State* state, int index) {
     RawSet(state, index,
-           "createfrompath", &CreateOnHeap<nu::Image, const base::FilePath&>,
+           "createfrompath", &CreateFromPath,
+           "createfrombuffer", CFunction(&CreateFromBuffer),
+           "loadasync", CFunction(&LoadAsync),
+           "getplaceholder", &nu::Image::GetPlaceholder,
            "getsize", &nu::Image::GetSize,
            "getscalefactor", &nu::Image::GetScaleFactor);
   }
+  static nu::Image* CreateFromPath(CallContext* context,
+                                   const base::FilePath& path) {
+    nu::SizeF max_size;
+    if (GetType(context->state, 2) == LuaType::Table)
+      To(context->state, 2, &max_size);
+    return new nu::Image(path, max_size);
+  }
+  static int CreateFromBuffer(State* state) {
+    nu::Buffer buffer;
+    if (!To(state, 1, &buffer)) {
+      Push(state, "the arg 1 should be a string");
+      return lua_error(state);
+    }
+    float scale_factor = 1.f;
+    To(state, 2, &scale_factor);
+    scoped_refptr<nu::Image> image =
+        nu::Image::CreateFromBuffer(buffer, scale_factor);
+    Push(state, image.get());
+    return 1;
+  }
+  static int LoadAsync(State* state) {
+    bool success, yield = false;
+    {
+      base::FilePath path;
+      nu::SizeF max_size;
+      std::function<void(nu::Image*)> reply;
+      // The max size is optional.
+      int callback = 2;
+      if (GetType(state, 2) == LuaType::Table && To(state, 2, &max_size))
+        callback = 3;
+      success = To(state, 1, &path);
+      if (!success)
+        Push(state, "the arg 1 should be a file path");
+      else
+        success = GetAsyncReply(state, callback, &reply, &yield);
+      if (success) {
+        nu::Image::LoadAsync(path, max_size,
+                             [reply](scoped_refptr<nu::Image> image) {
+          reply(image.get());
+        });
+      }
+    }
+    // Throw error or yield after we are out of C++ stack.
+    if (!success)
+      return lua_error(state);
+    return yield ? lua_yield(state, 0) : 0;
+  }
+};
+
+template<>
+struct Type<nu::ImageCache::Stats> {
+  static constexpr const char* name = "yue.ImageCache.Stats";
+  static inline void Push(State* state, const nu::ImageCache::Stats& stats) {
+    NewTable(state, 0, 5);
+    RawSet(state, -1,
+           "hits", stats.hits,
+           "misses", stats.misses,
+           "evictions", stats.evictions,
+           "count", stats.count,
+           "memoryusage", stats.memory_usage);
+  }
+};
+
+template<>
+struct Type<nu::ImageCache> {
+  static constexpr const char* name = "yue.ImageCache";
+  static void BuildMetaTable(State* state, int index) {
+    RawSet(state, index,
+           "setcapacity", &nu::ImageCache::SetCapacity,
+           "getcapacity", &nu::ImageCache::GetCapacity,
+           "getstats", &nu::ImageCache::GetStats,
+           "resetstats", &nu::ImageCache::ResetStats,
+           "clear", &nu::ImageCache::Clear);
+  }
+};
+
+template<>
+struct Type<nu::PixelOps::InstructionSet> {
+  static constexpr const char* name = "yue.PixelOps.InstructionSet";
+  static inline void Push(State* state, nu::PixelOps::InstructionSet set) {
+    if (set == nu::PixelOps::InstructionSet::AVX2)
+      lua::Push(state, "avx2");
+    else if (set == nu::PixelOps::InstructionSet::SSE2)
+      lua::Push(state, "sse2");
+    else
+      lua::Push(state, "scalar");
+  }
+  static inline bool To(State* state, int index,
+                        nu::PixelOps::InstructionSet* out) {
+    std::string set;
+    if (!lua::To(state, index, &set))
+      return false;
+    if (set == "avx2") {
+      *out = nu::PixelOps::InstructionSet::AVX2;
+      return true;
+    } else if (set == "sse2") {
+      *out = nu::PixelOps::InstructionSet::SSE2;
+      return true;
+    } else if (set == "scalar") {
+      *out = nu::PixelOps::InstructionSet::Scalar;
+      return true;
+    }
+    return false;
+  }
+};
+
+template<>
+struct Type<nu::PixelOps> {
+  static constexpr const char* name = "yue.PixelOps";
+  static void BuildMetaTable(State* state, int index) {
+    RawSet(state, index,
+           "getinstructionset", &nu::PixelOps::GetInstructionSet,
+           "setinstructionset", &nu::PixelOps::SetInstructionSet,
+           "createcanvasfromimage", CFunction(&CreateCanvasFromImage),
+           "boxblur", &nu::PixelOps::BoxBlur,
+           "applycolormatrix", &nu::PixelOps::ApplyColorMatrix,
+           "blend", &nu::PixelOps::Blend);
+  }
+  static int CreateCanvasFromImage(State* state) {
+    nu::Image* image;
+    if (!To(state, 1, &image)) {
+      Push(state, "the arg 1 should be an Image");
+      return lua_error(state);
+    }
+    scoped_refptr<nu::Canvas> canvas =
+        nu::PixelOps::CreateCanvasFromImage(image);
+    Push(state, canvas.get());
+    return 1;
+  }
 };
 
 template<>
@@ -420,6 +752,24 @@ struct Type<nu::TextMetrics> {
   }
 };
 
+template<>
+struct Type<nu::Path> {
+  static constexpr const char* name = "yue.Path";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "create", &CreateOnHeap<nu::Path>,
+           "moveto", &nu::Path::MoveTo,
+           "lineto", &nu::Path::LineTo,
+           "beziercurveto", &nu::Path::BezierCurveTo,
+           "arc", &nu::Path::Arc,
+           "rect", &nu::Path::Rect,
+           "closepath", &nu::Path::ClosePath,
+           "translate", &nu::Path::Translate,
+           "rotate", &nu::Path::Rotate,
+           "scale", &nu::Path::Scale);
+  }
+};
+
 template<>
 struct Type<nu::Painter> {
   static constexpr const char* name = "yue.Painter";
@@ -445,6 +795,9 @@ struct Type<nu::Painter> {
            "setlinewidth", &nu::Painter::SetLineWidth,
            "stroke", &nu::Painter::Stroke,
            "fill", &nu::Painter::Fill,
+           "strokepath", &nu::Painter::StrokePath,
+           "fillpath", &nu::Painter::FillPath,
+           "clippath", &nu::Painter::ClipPath,
            "strokerect", &nu::Painter::StrokeRect,
            "fillrect", &nu::Painter::FillRect,
            "drawimage", &nu::Painter::DrawImage,
@@ -452,7 +805,8 @@ struct Type<nu::Painter> {
            "drawcanvas", &nu::Painter::DrawCanvas,
            "drawcanvasfromrect", &nu::Painter::DrawCanvasFromRect,
            "measuretext", &nu::Painter::MeasureText,
-           "drawtext", &nu::Painter::DrawText);
+           "drawtext", &nu::Painter::DrawText,
+           "execute", &nu::Painter::Execute);
   }
 };
 
@@ -1168,6 +1522,18 @@ struct Type<nu::ProtocolStringJob> {
   }
 };
 
+template<>
+struct Type<nu::ProtocolBufferJob> {
+  using base = nu::ProtocolStringJob;
+  static constexpr const char* name = "yue.ProtocolBufferJob";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "create", &CreateOnHeap<nu::ProtocolBufferJob,
+                                   const std::string&,
+                                   const nu::Buffer&>);
+  }
+};
+
 template<>
 struct Type<nu::ProtocolFileJob> {
   using base = nu::ProtocolJob;
@@ -1214,6 +1580,8 @@ struct Type<nu::Browser> {
            "reload", &nu::Browser::Reload,
            "stop", &nu::Browser::Stop,
            "setbindingname", &nu::Browser::SetBindingName,
+           "setbindingbatching", &nu::Browser::SetBindingBatching,
+           "isbindingbatching", &nu::Browser::IsBindingBatching,
            "addbinding", &AddBinding,
            "addrawbinding", &nu::Browser::AddRawBinding,
            "removebinding", &nu::Browser::RemoveBinding);
@@ -1360,6 +1728,7 @@ struct Type<nu::TextEdit> {
            "canredo", &nu::TextEdit::CanRedo,
            "undo", &nu::TextEdit::Undo,
            "canundo", &nu::TextEdit::CanUndo,
+           "setundolimit", &nu::TextEdit::SetUndoLimit,
            "cut", &nu::TextEdit::Cut,
            "copy", &nu::TextEdit::Copy,
            "paste", &nu::TextEdit::Paste,
@@ -1370,12 +1739,78 @@ struct Type<nu::TextEdit> {
            "inserttext", &nu::TextEdit::InsertText,
            "inserttextat", &nu::TextEdit::InsertTextAt,
            "delete", &nu::TextEdit::Delete,
-           "deleterange", &nu::TextEdit::DeleteRange);
+           "deleterange", &nu::TextEdit::DeleteRange,
+           "appendtext", &nu::TextEdit::AppendText,
+           "flushappendedtext", &nu::TextEdit::FlushAppendedText,
+           "setmaxlines", &nu::TextEdit::SetMaxLines,
+           "getmaxlines", &nu::TextEdit::GetMaxLines);
     RawSetProperty(state, metatable,
                    "ontextchange", &nu::TextEdit::on_text_change);
   }
 };
 
+template<>
+struct Type<nu::Animation::Easing> {
+  static constexpr const char* name = "yue.Animation.Easing";
+  static inline bool To(State* state, int index,
+                        nu::Animation::Easing* out) {
+    std::string easing;
+    if (!lua::To(state, index, &easing))
+      return false;
+    if (easing == "linear") {
+      *out = nu::Animation::Easing::Linear;
+      return true;
+    } else if (easing == "ease-in") {
+      *out = nu::Animation::Easing::EaseIn;
+      return true;
+    } else if (easing == "ease-out") {
+      *out = nu::Animation::Easing::EaseOut;
+      return true;
+    } else if (easing == "ease-in-out") {
+      *out = nu::Animation::Easing::EaseInOut;
+      return true;
+    } else {
+      return false;
+    }
+  }
+  static inline void Push(State* state, nu::Animation::Easing easing) {
+    if (easing == nu::Animation::Easing::EaseIn)
+      lua::Push(state, "ease-in");
+    else if (easing == nu::Animation::Easing::EaseOut)
+      lua::Push(state, "ease-out");
+    else if (easing == nu::Animation::Easing::EaseInOut)
+      lua::Push(state, "ease-in-out");
+    else
+      lua::Push(state, "linear");
+  }
+};
+
+template<>
+struct Type<nu::Animation> {
+  static constexpr const char* name = "yue.Animation";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "create", &CreateOnHeap<nu::Animation, nu::View*>,
+           "setduration", &nu::Animation::SetDuration,
+           "getduration", &nu::Animation::GetDuration,
+           "seteasing", &nu::Animation::SetEasing,
+           "geteasing", &nu::Animation::GetEasing,
+           "animatestyle", &nu::Animation::AnimateStyle,
+           "animatebounds", &nu::Animation::AnimateBounds,
+           "animatecolor", &nu::Animation::AnimateColor,
+           "animatebackgroundcolor", &nu::Animation::AnimateBackgroundColor,
+           "animatevalue", &nu::Animation::AnimateValue,
+           "getvalue", &nu::Animation::GetValue,
+           "start", &nu::Animation::Start,
+           "stop", &nu::Animation::Stop,
+           "isrunning", &nu::Animation::IsRunning,
+           "getprogress", &nu::Animation::GetProgress,
+           "getview", &nu::Animation::GetView);
+    RawSetProperty(state, metatable,
+                   "onfinish", &nu::Animation::on_finish);
+  }
+};
+
 #if defined(OS_MACOSX)
 template<>
 struct Type<nu::Vibrant::Material> {
@@ -1476,11 +1911,15 @@ extern "C" int luaopen_yue_gui(lua::State* state) {
   // Classes.
   BindType<nu::Lifetime>(state, "Lifetime");
   BindType<nu::MessageLoop>(state, "MessageLoop");
+  BindType<nu::ThreadPool>(state, "ThreadPool");
   BindType<nu::App>(state, "App");
   BindType<nu::Font>(state, "Font");
   BindType<nu::Canvas>(state, "Canvas");
+  BindType<nu::Path>(state, "Path");
   BindType<nu::Color>(state, "Color");
   BindType<nu::Image>(state, "Image");
+  BindType<nu::ImageCache>(state, "ImageCache");
+  BindType<nu::PixelOps>(state, "PixelOps");
   BindType<nu::Painter>(state, "Painter");
   BindType<nu::Event>(state, "Event");
   BindType<nu::FileDialog>(state, "FileDialog");
@@ -1493,6 +1932,7 @@ extern "C" int luaopen_yue_gui(lua::State* state) {
   BindType<nu::Container>(state, "Container");
   BindType<nu::Button>(state, "Button");
   BindType<nu::ProtocolStringJob>(state, "ProtocolStringJob");
+  BindType<nu::ProtocolBufferJob>(state, "ProtocolBufferJob");
   BindType<nu::ProtocolFileJob>(state, "ProtocolFileJob");
   BindType<nu::ProtocolAsarJob>(state, "ProtocolAsarJob");
   BindType<nu::Browser>(state, "Browser");
@@ -1502,6 +1942,7 @@ extern "C" int luaopen_yue_gui(lua::State* state) {
   BindType<nu::Group>(state, "Group");
   BindType<nu::Scroll>(state, "Scroll");
   BindType<nu::TextEdit>(state, "TextEdit");
+  BindType<nu::Animation>(state, "Animation");
 #if defined(OS_MACOSX)
   BindType<nu::Toolbar>(state, "Toolbar");
   BindType<nu::Vibrant>(state, "Vibrant");
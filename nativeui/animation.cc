@@ -0,0 +1,296 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/animation.h"
+
+#include <algorithm>
+#include <map>
+
+#include "base/lazy_instance.h"
+#include "nativeui/message_loop.h"
+#include "nativeui/view.h"
+#include "nativeui/window.h"
+
+namespace nu {
+
+namespace {
+
+float Ease(Animation::Easing easing, float t) {
+  switch (easing) {
+    case Animation::Easing::EaseIn:
+      return t * t * t;
+    case Animation::Easing::EaseOut:
+      return 1.f - (1.f - t) * (1.f - t) * (1.f - t);
+    case Animation::Easing::EaseInOut:
+      return t < 0.5f ? 4.f * t * t * t
+                      : 1.f - 4.f * (1.f - t) * (1.f - t) * (1.f - t);
+    default:
+      return t;
+  }
+}
+
+inline float Interpolate(float from, float to, float progress) {
+  return from + (to - from) * progress;
+}
+
+Color Interpolate(Color from, Color to, float progress) {
+  auto channel = [progress](unsigned from, unsigned to) {
+    return static_cast<unsigned>(
+        Interpolate(static_cast<float>(from), static_cast<float>(to),
+                    progress) + 0.5f);
+  };
+  return Color(channel(from.a(), to.a()), channel(from.r(), to.r()),
+               channel(from.g(), to.g()), channel(from.b(), to.b()));
+}
+
+RectF Interpolate(const RectF& from, const RectF& to, float progress) {
+  return RectF(Interpolate(from.x(), to.x(), progress),
+               Interpolate(from.y(), to.y(), progress),
+               Interpolate(from.width(), to.width(), progress),
+               Interpolate(from.height(), to.height(), progress));
+}
+
+}  // namespace
+
+// Keeps running animations grouped by window, and steps them in the frame
+// callbacks of windows.
+class AnimationScheduler {
+ public:
+  AnimationScheduler() {}
+
+  void Add(Animation* animation) {
+    Window* window = animation->window_;
+    WindowAnimations& entry = windows_[window];
+    if (!entry.window) {
+      entry.window = window;
+      entry.id = ++next_id_;
+      entry.on_close_id = window->on_close.Connect(
+          [this](Window* closed) { RemoveWindow(closed); });
+    }
+    entry.animations.push_back(animation);
+    RequestFrame(window, &entry);
+  }
+
+  void Remove(Animation* animation) {
+    auto it = windows_.find(animation->window_);
+    if (it == windows_.end())
+      return;
+    auto& animations = it->second.animations;
+    animations.erase(
+        std::remove(animations.begin(), animations.end(), animation),
+        animations.end());
+    // The pending frame callback would be ignored since the id changes.
+    if (animations.empty())
+      Erase(it);
+  }
+
+ private:
+  struct WindowAnimations {
+    // Keep the window alive while its animations are running.
+    scoped_refptr<Window> window;
+    std::vector<scoped_refptr<Animation>> animations;
+    // Identifies the entry in frame callbacks, since an entry can be removed
+    // and added again before its requested frame comes.
+    int id = 0;
+    bool frame_requested = false;
+    int on_close_id = 0;
+  };
+
+  using WindowMap = std::map<Window*, WindowAnimations>;
+
+  void Erase(WindowMap::iterator it) {
+    it->second.window->on_close.Disconnect(it->second.on_close_id);
+    windows_.erase(it);
+  }
+
+  // Stop all animations of a closed window, otherwise they would keep the
+  // window alive and wait for frames that never come.
+  void RemoveWindow(Window* window) {
+    auto it = windows_.find(window);
+    if (it == windows_.end())
+      return;
+    scoped_refptr<Window> ref(it->second.window);
+    std::vector<scoped_refptr<Animation>> animations;
+    animations.swap(it->second.animations);
+    Erase(it);
+    for (const auto& animation : animations) {
+      animation->running_ = false;
+      animation->window_ = nullptr;
+    }
+    // This may be the last reference, release the window after the on_close
+    // signal has been handled.
+    MessageLoop::PostTask([ref]() {});
+  }
+
+  void RequestFrame(Window* window, WindowAnimations* entry) {
+    if (entry->frame_requested)
+      return;
+    entry->frame_requested = true;
+    int id = entry->id;
+    MessageLoop::RequestFrame(window, [this, window, id](double time) {
+      OnFrame(window, id, time);
+    });
+  }
+
+  void OnFrame(Window* window, int id, double time) {
+    auto it = windows_.find(window);
+    if (it == windows_.end() || it->second.id != id)
+      return;
+    it->second.frame_requested = false;
+    // Signals emitted during the frame may start or stop animations, so work
+    // on a copy and skip stopped ones.
+    scoped_refptr<Window> keep_alive(it->second.window);
+    std::vector<scoped_refptr<Animation>> animations(it->second.animations);
+
+    // Set style properties of all animations, and then do layout once.
+    bool needs_layout = false;
+    std::vector<scoped_refptr<Animation>> finished;
+    for (const auto& animation : animations) {
+      if (!animation->running_)
+        continue;
+      if (animation->StepStyles(time))
+        finished.push_back(animation);
+      needs_layout |= !animation->styles_.empty();
+    }
+    if (needs_layout)
+      window->GetContentView()->Layout();
+    for (const auto& animation : animations) {
+      if (animation->running_)
+        animation->ApplyOtherProperties();
+    }
+
+    // Animations stopped in this frame do not finish.
+    finished.erase(
+        std::remove_if(finished.begin(), finished.end(),
+                       [](const scoped_refptr<Animation>& animation) {
+                         return !animation->running_;
+                       }),
+        finished.end());
+    for (const auto& animation : finished) {
+      Remove(animation.get());
+      animation->running_ = false;
+      animation->window_ = nullptr;
+    }
+    it = windows_.find(window);
+    if (it != windows_.end())
+      RequestFrame(window, &it->second);
+    for (const auto& animation : finished)
+      animation->on_finish.Emit(animation.get());
+  }
+
+  int next_id_ = 0;
+  WindowMap windows_;
+
+  DISALLOW_COPY_AND_ASSIGN(AnimationScheduler);
+};
+
+namespace {
+
+base::LazyInstance<AnimationScheduler>::Leaky g_scheduler =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+Animation::Animation(View* view) : view_(view) {
+}
+
+Animation::~Animation() {
+}
+
+void Animation::SetDuration(int ms) {
+  duration_ = std::max(ms, 0);
+}
+
+void Animation::SetEasing(Easing easing) {
+  easing_ = easing;
+}
+
+void Animation::AnimateStyle(const std::string& name, float from, float to) {
+  styles_.push_back({name, from, to});
+}
+
+void Animation::AnimateBounds(const RectF& from, const RectF& to) {
+  has_bounds_ = true;
+  bounds_from_ = from;
+  bounds_to_ = to;
+}
+
+void Animation::AnimateColor(Color from, Color to) {
+  has_color_ = true;
+  color_from_ = from;
+  color_to_ = to;
+}
+
+void Animation::AnimateBackgroundColor(Color from, Color to) {
+  has_background_color_ = true;
+  background_color_from_ = from;
+  background_color_to_ = to;
+}
+
+void Animation::AnimateValue(float from, float to) {
+  has_value_ = true;
+  value_from_ = from;
+  value_to_ = to;
+  value_ = from;
+}
+
+void Animation::Start() {
+  if (running_)
+    Stop();
+  start_time_ = -1;
+  progress_ = 0.f;
+  window_ = view_->GetWindow();
+  if (!window_) {
+    // Nothing would be painted, jump to the end.
+    scoped_refptr<Animation> keep_alive(this);
+    progress_ = 1.f;
+    for (const StyleTarget& style : styles_)
+      view_->SetStyleProperty(style.name, style.to);
+    if (!styles_.empty())
+      view_->Layout();
+    ApplyOtherProperties();
+    on_finish.Emit(this);
+    return;
+  }
+  running_ = true;
+  g_scheduler.Get().Add(this);
+}
+
+void Animation::Stop() {
+  if (!running_)
+    return;
+  scoped_refptr<Animation> keep_alive(this);
+  g_scheduler.Get().Remove(this);
+  running_ = false;
+  window_ = nullptr;
+}
+
+bool Animation::StepStyles(double time) {
+  if (start_time_ < 0)
+    start_time_ = time;
+  float t = duration_ > 0 ?
+      std::min(static_cast<float>((time - start_time_) / duration_), 1.f) :
+      1.f;
+  progress_ = Ease(easing_, t);
+  for (const StyleTarget& style : styles_)
+    view_->SetStyleProperty(style.name,
+                            Interpolate(style.from, style.to, progress_));
+  return t >= 1.f;
+}
+
+void Animation::ApplyOtherProperties() {
+  if (has_bounds_)
+    view_->SetBounds(Interpolate(bounds_from_, bounds_to_, progress_));
+  if (has_color_)
+    view_->SetColor(Interpolate(color_from_, color_to_, progress_));
+  if (has_background_color_)
+    view_->SetBackgroundColor(
+        Interpolate(background_color_from_, background_color_to_, progress_));
+  if (has_value_) {
+    value_ = Interpolate(value_from_, value_to_, progress_);
+    view_->SchedulePaint();
+  }
+}
+
+}  // namespace nu
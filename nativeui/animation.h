@@ -0,0 +1,125 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_ANIMATION_H_
+#define NATIVEUI_ANIMATION_H_
+
+#include <string>
+#include <vector>
+
+#include "base/memory/ref_counted.h"
+#include "nativeui/gfx/color.h"
+#include "nativeui/gfx/geometry/rect_f.h"
+#include "nativeui/signal.h"
+
+namespace nu {
+
+class View;
+class Window;
+
+// Interpolate properties of a view on the frame clock of its window.
+//
+// All animations of a window are stepped together in the frame callback, the
+// layout is computed at most once per frame no matter how many style
+// properties are animated.
+class NATIVEUI_EXPORT Animation : public base::RefCounted<Animation> {
+ public:
+  enum class Easing {
+    Linear,
+    EaseIn,
+    EaseOut,
+    EaseInOut,
+  };
+
+  explicit Animation(View* view);
+
+  // The duration in milliseconds, default is 250.
+  void SetDuration(int ms);
+  int GetDuration() const { return duration_; }
+
+  void SetEasing(Easing easing);
+  Easing GetEasing() const { return easing_; }
+
+  // Animate a numeric style property, like "width" or "margin-left".
+  void AnimateStyle(const std::string& name, float from, float to);
+
+  // Animate the bounds, which are applied after the layout of each frame.
+  void AnimateBounds(const RectF& from, const RectF& to);
+
+  // Animate the colors of view.
+  void AnimateColor(Color from, Color to);
+  void AnimateBackgroundColor(Color from, Color to);
+
+  // Animate a custom value, which can be read in the on_draw handler of the
+  // view for painter parameters. The view is repainted in every frame.
+  void AnimateValue(float from, float to);
+  float GetValue() const { return value_; }
+
+  // Start from the beginning. When the view is not in a window, the final
+  // values are applied immediately. Closing the window stops the animation.
+  void Start();
+
+  // Stop at current values without emitting on_finish.
+  void Stop();
+
+  bool IsRunning() const { return running_; }
+
+  // Return the eased progress in [0, 1].
+  float GetProgress() const { return progress_; }
+
+  View* GetView() const { return view_.get(); }
+
+  // Events.
+  Signal<void(Animation*)> on_finish;
+
+ protected:
+  virtual ~Animation();
+
+ private:
+  friend class base::RefCounted<Animation>;
+  friend class AnimationScheduler;
+
+  struct StyleTarget {
+    std::string name;
+    float from;
+    float to;
+  };
+
+  // Compute progress for |time| and set style properties, return whether the
+  // animation has reached the end.
+  bool StepStyles(double time);
+  // Apply the properties that must be set after layout.
+  void ApplyOtherProperties();
+
+  scoped_refptr<View> view_;
+  int duration_ = 250;
+  Easing easing_ = Easing::Linear;
+
+  std::vector<StyleTarget> styles_;
+  bool has_bounds_ = false;
+  RectF bounds_from_;
+  RectF bounds_to_;
+  bool has_color_ = false;
+  Color color_from_;
+  Color color_to_;
+  bool has_background_color_ = false;
+  Color background_color_from_;
+  Color background_color_to_;
+  bool has_value_ = false;
+  float value_from_ = 0.f;
+  float value_to_ = 0.f;
+  float value_ = 0.f;
+
+  // State of running animation, |start_time_| is set by the first frame.
+  bool running_ = false;
+  Window* window_ = nullptr;
+  double start_time_ = -1;
+  float progress_ = 0.f;
+
+  DISALLOW_COPY_AND_ASSIGN(Animation);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_ANIMATION_H_
@@ -0,0 +1,141 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <algorithm>
+#include <vector>
+
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class AnimationTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    window_ = new nu::Window(nu::Window::Options());
+    window_->SetContentSize(nu::SizeF(400, 400));
+    view_ = new nu::Container;
+    static_cast<nu::Container*>(window_->GetContentView())->AddChildView(
+        view_.get());
+    window_->SetVisible(true);
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::Window> window_;
+  scoped_refptr<nu::Container> view_;
+};
+
+TEST_F(AnimationTest, AnimateStyle) {
+  scoped_refptr<nu::Animation> animation(new nu::Animation(view_.get()));
+  animation->SetDuration(50);
+  animation->AnimateStyle("width", 10, 100);
+  animation->AnimateStyle("height", 10, 50);
+  int finished = 0;
+  animation->on_finish.Connect([&](nu::Animation*) {
+    ++finished;
+    nu::MessageLoop::Quit();
+  });
+  animation->Start();
+  EXPECT_TRUE(animation->IsRunning());
+  nu::MessageLoop::Run();
+  EXPECT_EQ(finished, 1);
+  EXPECT_FALSE(animation->IsRunning());
+  EXPECT_EQ(animation->GetProgress(), 1.f);
+  EXPECT_EQ(view_->GetBounds().size(), nu::SizeF(100, 50));
+}
+
+TEST_F(AnimationTest, AnimateValue) {
+  scoped_refptr<nu::Animation> animation(new nu::Animation(view_.get()));
+  animation->SetDuration(50);
+  animation->SetEasing(nu::Animation::Easing::EaseInOut);
+  animation->AnimateValue(1, 3);
+  EXPECT_EQ(animation->GetValue(), 1.f);
+  std::vector<float> values;
+  view_->on_draw.Connect([&](nu::Container*, nu::Painter*, const nu::RectF&) {
+    values.push_back(animation->GetValue());
+  });
+  animation->on_finish.Connect([](nu::Animation*) {
+    nu::MessageLoop::Quit();
+  });
+  animation->Start();
+  nu::MessageLoop::Run();
+  EXPECT_EQ(animation->GetValue(), 3.f);
+  EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+}
+
+TEST_F(AnimationTest, AnimateTogether) {
+  // Animations of the same window are stepped in the same frames.
+  scoped_refptr<nu::Animation> a1(new nu::Animation(view_.get()));
+  a1->SetDuration(0);
+  a1->AnimateColor(nu::Color(0, 0, 0), nu::Color(255, 255, 255));
+  scoped_refptr<nu::Animation> a2(new nu::Animation(view_.get()));
+  a2->SetDuration(0);
+  a2->AnimateBackgroundColor(nu::Color(0, 0, 0), nu::Color(255, 0, 0));
+  std::vector<nu::Animation*> finished;
+  auto on_finish = [&](nu::Animation* animation) {
+    finished.push_back(animation);
+    if (finished.size() == 2)
+      nu::MessageLoop::Quit();
+  };
+  a1->on_finish.Connect(on_finish);
+  a2->on_finish.Connect(on_finish);
+  a1->Start();
+  a2->Start();
+  nu::MessageLoop::Run();
+  ASSERT_EQ(finished.size(), 2u);
+  EXPECT_EQ(finished[0], a1.get());
+  EXPECT_EQ(finished[1], a2.get());
+}
+
+TEST_F(AnimationTest, Stop) {
+  scoped_refptr<nu::Animation> animation(new nu::Animation(view_.get()));
+  animation->SetDuration(1000);
+  animation->AnimateValue(0, 1);
+  bool finished = false;
+  animation->on_finish.Connect([&](nu::Animation*) {
+    finished = true;
+  });
+  animation->Start();
+  animation->Stop();
+  EXPECT_FALSE(animation->IsRunning());
+  nu::MessageLoop::PostDelayedTask(50, []() {
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+  EXPECT_FALSE(finished);
+  EXPECT_EQ(animation->GetValue(), 0.f);
+}
+
+TEST_F(AnimationTest, CloseWindow) {
+  scoped_refptr<nu::Animation> animation(new nu::Animation(view_.get()));
+  animation->SetDuration(1000);
+  animation->AnimateValue(0, 1);
+  bool finished = false;
+  animation->on_finish.Connect([&](nu::Animation*) {
+    finished = true;
+  });
+  animation->Start();
+  window_->Close();
+  EXPECT_FALSE(animation->IsRunning());
+  nu::MessageLoop::PostDelayedTask(50, []() {
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+  EXPECT_FALSE(finished);
+  // The closed window is no longer referenced by animations.
+  EXPECT_TRUE(window_->HasOneRef());
+}
+
+TEST_F(AnimationTest, NotInWindow) {
+  scoped_refptr<nu::Container> view(new nu::Container);
+  scoped_refptr<nu::Animation> animation(new nu::Animation(view.get()));
+  animation->AnimateBounds(nu::RectF(0, 0, 10, 10), nu::RectF(0, 0, 20, 20));
+  bool finished = false;
+  animation->on_finish.Connect([&](nu::Animation*) {
+    finished = true;
+  });
+  animation->Start();
+  EXPECT_TRUE(finished);
+  EXPECT_FALSE(animation->IsRunning());
+  EXPECT_EQ(view->GetBounds(), nu::RectF(0, 0, 20, 20));
+}
@@ -34,8 +34,9 @@ Color App::GetColor(ThemeColor name) {
 }
 
 Font* App::GetDefaultFont() {
+  // Requesting a font with the same attributes gets the default font.
   if (!default_font_)
-    default_font_ = new Font;
+    default_font_ = Font::Intern(new Font);
   return default_font_.get();
 }
 
@@ -103,6 +103,16 @@ bool AsarArchive::GetFileInfo(const std::string& path, FileInfo* info) {
   return true;
 }
 
+bool AsarArchive::MapFile(const std::string& path,
+                          base::MemoryMappedFile* mapped_file) {
+  FileInfo info;
+  if (!IsValid() || !GetFileInfo(path, &info) || info.size == 0)
+    return false;
+  base::MemoryMappedFile::Region region = {
+      static_cast<int64_t>(info.offset), info.size };
+  return mapped_file->Initialize(file_.Duplicate(), region);
+}
+
 bool AsarArchive::ReadExtendedMeta() {
   // Read last 13 bytes, which are | size(8) | version(1) | magic(4) |.
   char magic[5] = { 0 };
@@ -8,6 +8,7 @@
 #include <string>
 
 #include "base/files/file.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/values.h"
 #include "nativeui/nativeui_export.h"
 
@@ -26,6 +27,9 @@ class NATIVEUI_EXPORT AsarArchive {
   bool IsValid() const;
   bool GetFileInfo(const std::string& path, FileInfo* info);
 
+  // Map the content of file at |path| into memory.
+  bool MapFile(const std::string& path, base::MemoryMappedFile* mapped_file);
+
  private:
   bool ReadExtendedMeta();
 
@@ -38,6 +38,14 @@ void Browser::SetBindingName(const std::string& name) {
     PlatformUpdateBindings();
 }
 
+void Browser::SetBindingBatching(bool batching) {
+  if (binding_batching_ == batching)
+    return;
+  binding_batching_ = batching;
+  if (!stop_serving_)
+    PlatformUpdateBindings();
+}
+
 void Browser::AddRawBinding(const std::string& name, const BindingFunc& func) {
   if (name.empty())
     return;
@@ -68,12 +76,23 @@ bool Browser::InvokeBindings(const std::string& key,
     LOG(ERROR) << "Recevied invalid key, stop serving navite bindings";
     return false;
   }
-  auto it = bindings_.find(method);
-  if (it == bindings_.end()) {
-    LOG(ERROR) << "Invoking invalid method: " << method;
-    return false;
+  if (!method.empty())
+    return CallBinding(method, std::move(args));
+  // An empty method means a batch of [method, args] calls, bindings may
+  // release or stop the browser in the middle of the batch.
+  scoped_refptr<Browser> self(this);
+  for (base::Value& call : args.GetList()) {
+    if (stop_serving_)
+      return false;
+    if (!call.is_list() || call.GetList().size() != 2 ||
+        !call.GetList()[0].is_string() || !call.GetList()[1].is_list()) {
+      LOG(ERROR) << "Invalid batched call";
+      return false;
+    }
+    if (!CallBinding(call.GetList()[0].GetString(),
+                     std::move(call.GetList()[1])))
+      return false;
   }
-  it->second(this, std::move(args));
   return true;
 }
 
@@ -87,17 +106,42 @@ std::string Browser::GetBindingScript() {
     name = base::StringPrintf("window[\"%s\"]", name.c_str());
     code = name + " = {};" + code;
   }
+  // Send a message to native side.
+#if defined(OS_WIN)
+  // On WebKit we can only pass one argument.
+  code += "var post = function(method, args) {"
+          "  external.postMessage(key, method, JSON.stringify(args));"
+          "};";
+#else
+  code += "var post = function(method, args) {"
+          "  external.postMessage([key, method, args]);"
+          "};";
+#endif
+  if (binding_batching_) {
+    // Queue the calls and post them with empty method after current task.
+    code += "var queue = [];"
+            "var flush = function() {"
+            "  var calls = queue;"
+            "  queue = [];"
+            "  post(\"\", calls);"
+            "};"
+            "var call = function(method, args) {"
+            "  if (queue.length == 0) {"
+            "    if (window.Promise)"
+            "      Promise.resolve().then(flush);"
+            "    else"
+            "      setTimeout(flush, 0);"
+            "  }"
+            "  queue.push([method, args]);"
+            "};";
+  } else {
+    code += "var call = post;";
+  }
   // Insert bindings.
   for (const auto& it : bindings_) {
     code += base::StringPrintf(
         "binding[\"%s\"] = function() {"
-        "  var args = Array.prototype.slice.call(arguments);"
-#if defined(OS_WIN)
-        // On WebKit we can only pass one argument.
-        "  external.postMessage(key, \"%s\", JSON.stringify(args));"
-#else
-        "  external.postMessage([key, \"%s\", args]);"
-#endif
+        "  call(\"%s\", Array.prototype.slice.call(arguments));"
         "};",
         it.first.c_str(), it.first.c_str());
   }
@@ -112,4 +156,14 @@ std::string Browser::GetBindingScript() {
   return code;
 }
 
+bool Browser::CallBinding(const std::string& method, base::Value args) {
+  auto it = bindings_.find(method);
+  if (it == bindings_.end()) {
+    LOG(ERROR) << "Invoking invalid method: " << method;
+    return false;
+  }
+  it->second(this, std::move(args));
+  return true;
+}
+
 }  // namespace nu
@@ -51,6 +51,12 @@ class NATIVEUI_EXPORT Browser : public View {
   void Stop();
 
   void SetBindingName(const std::string& name);
+
+  // Queue calls to bindings made in the same task, and deliver them in one
+  // message after the task, in the order they are called.
+  void SetBindingBatching(bool batching);
+  bool IsBindingBatching() const { return binding_batching_; }
+
   void AddRawBinding(const std::string& name, const BindingFunc& func);
   void RemoveBinding(const std::string& name);
 
@@ -96,11 +102,15 @@ class NATIVEUI_EXPORT Browser : public View {
   void PlatformDestroy();
   void PlatformUpdateBindings();
 
+  // Call the binding with |method|, return false if it does not exist.
+  bool CallBinding(const std::string& method, base::Value args);
+
   // Prevent malicous calls to native bindings.
   std::string security_key_;
   bool stop_serving_ = false;
 
   std::string binding_name_;
+  bool binding_batching_ = false;
   std::map<std::string, BindingFunc> bindings_;
 };
 
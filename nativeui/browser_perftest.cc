@@ -0,0 +1,124 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/timer/elapsed_timer.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+const int kIterations = 10;
+
+// Generates an array that is about 1MB as JSON.
+const char kPayloadScript[] =
+    "window.payload = [];"
+    "for (var i = 0; i < 10000; ++i) {"
+    "  payload.push({id: i, name: 'item ' + i, tags: ['a', 'b', 'c'],"
+    "                value: i / 3, enabled: i % 2 == 0});"
+    "}";
+
+}  // namespace
+
+class BrowserPerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    browser_ = new nu::Browser;
+  }
+
+  // Load a page with the payload and run |task| after it is loaded.
+  void LoadPayload(const std::function<void()>& task) {
+    browser_->on_finish_navigation.Connect([=](nu::Browser*,
+                                               const std::string&) {
+      task();
+    });
+    nu::MessageLoop::PostTask([=]() {
+      browser_->LoadHTML(std::string("<body><script>") + kPayloadScript +
+                         "</script></body>", "about:blank");
+    });
+    nu::MessageLoop::Run();
+  }
+
+  void LogResult(const std::string& label, const base::Value& value) {
+    std::string json;
+    base::JSONWriter::Write(value, &json);
+    LOG(INFO) << label << ": " << timer_->Elapsed().InMilliseconds() << "ms"
+              << " for " << kIterations << " payloads of " << json.size() / 1024
+              << "KB";
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::Browser> browser_;
+  std::unique_ptr<base::ElapsedTimer> timer_;
+  int count_ = 0;
+};
+
+TEST_F(BrowserPerfTest, ExecuteJavaScriptResult) {
+  std::function<void(bool, base::Value)> on_result =
+      [&](bool success, base::Value result) {
+    ASSERT_TRUE(success);
+    ASSERT_TRUE(result.is_list());
+    if (++count_ < kIterations) {
+      browser_->ExecuteJavaScript("payload", on_result);
+      return;
+    }
+    LogResult("JS to native by ExecuteJavaScript", result);
+    nu::MessageLoop::Quit();
+  };
+  LoadPayload([&]() {
+    timer_.reset(new base::ElapsedTimer);
+    browser_->ExecuteJavaScript("payload", on_result);
+  });
+}
+
+TEST_F(BrowserPerfTest, BindingArguments) {
+  browser_->AddRawBinding("receive", [&](nu::Browser*, base::Value args) {
+    ASSERT_TRUE(args.is_list());
+    if (++count_ < kIterations)
+      return;
+    LogResult("JS to native by bindings", args);
+    nu::MessageLoop::Quit();
+  });
+  LoadPayload([&]() {
+    timer_.reset(new base::ElapsedTimer);
+    browser_->ExecuteJavaScript(
+        "for (var i = 0; i < " + std::to_string(kIterations) + "; ++i)"
+        "  window.receive(payload)",
+        nullptr);
+  });
+}
+
+TEST_F(BrowserPerfTest, NativeToJavaScript) {
+  base::Value payload;
+  std::string code;
+  std::function<void(bool, base::Value)> on_result =
+      [&](bool success, base::Value result) {
+    ASSERT_TRUE(success);
+    if (count_ == 0) {
+      // The first call gets the payload generated by script.
+      payload = std::move(result);
+      base::JSONWriter::Write(payload, &code);
+      code = "window.received = " + code + "; received.length";
+      timer_.reset(new base::ElapsedTimer);
+    } else {
+      ASSERT_TRUE(result.is_int());
+      if (count_ == kIterations) {
+        LogResult("Native to JS by ExecuteJavaScript", payload);
+        nu::MessageLoop::Quit();
+        return;
+      }
+    }
+    ++count_;
+    browser_->ExecuteJavaScript(code, on_result);
+  };
+  LoadPayload([&]() {
+    browser_->ExecuteJavaScript("payload", on_result);
+  });
+}
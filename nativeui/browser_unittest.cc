@@ -2,6 +2,8 @@
 // Use of this source code is governed by the license that can be found in the
 // LICENSE file.
 
+#include <vector>
+
 #include "base/base_paths.h"
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
@@ -235,6 +237,28 @@ TEST_F(BrowserTest, ExecuteJavaScriptComplexResult) {
   nu::MessageLoop::Run();
 }
 
+TEST_F(BrowserTest, ExecuteJavaScriptJSONSemantics) {
+  browser_->on_finish_navigation.Connect([](nu::Browser* browser,
+                                            const std::string& url) {
+    browser->ExecuteJavaScript(
+        "r = {u: undefined, f: function() {}, n: NaN, i: 2, d: 1.5,"
+        "     a: [undefined, function() {}, '\\u00e9'],"
+        "     t: {toJSON: () => 'j'}, o: Object.create({p: 1})}; r",
+        [](bool success, base::Value result) {
+      nu::MessageLoop::Quit();
+      ASSERT_EQ(success, true);
+      std::string json;
+      ASSERT_TRUE(base::JSONWriter::Write(result, &json));
+      ASSERT_EQ(json, "{\"a\":[null,null,\"\xC3\xA9\"],\"d\":1.5,\"i\":2,"
+                      "\"n\":null,\"o\":{},\"t\":\"j\"}");
+    });
+  });
+  nu::MessageLoop::PostTask([&]() {
+    browser_->LoadURL("about:blank");
+  });
+  nu::MessageLoop::Run();
+}
+
 TEST_F(BrowserTest, AddBinding) {
   bool bo = false;
   std::string st;
@@ -295,6 +319,29 @@ TEST_F(BrowserTest, SetBindingName) {
   nu::MessageLoop::Run();
 }
 
+TEST_F(BrowserTest, BindingBatching) {
+  browser_->SetBindingBatching(true);
+  std::vector<int> calls;
+  std::function<void(int)> handler = [&](int i) {
+    calls.push_back(i);
+    if (calls.size() == 100)
+      nu::MessageLoop::Quit();
+  };
+  browser_->AddBinding("method", handler);
+  browser_->on_finish_navigation.Connect([](nu::Browser* browser,
+                                            const std::string& url) {
+    browser->ExecuteJavaScript("for (var i = 0; i < 100; ++i) method(i)",
+                               nullptr);
+  });
+  nu::MessageLoop::PostTask([&]() {
+    browser_->LoadHTML("<body><script></script></body>", "about:blank");
+  });
+  nu::MessageLoop::Run();
+  ASSERT_EQ(calls.size(), 100u);
+  for (int i = 0; i < 100; ++i)
+    EXPECT_EQ(calls[i], i);
+}
+
 TEST_F(BrowserTest, MalicousCall) {
   bool called = false;
   browser_->AddRawBinding("method", [&called](nu::Browser*, base::Value) {
@@ -375,6 +422,44 @@ TEST_F(BrowserTest, FileProtocol) {
   nu::MessageLoop::Run();
 }
 
+TEST_F(BrowserTest, FileJobRead) {
+  base::ScopedTempDir dir;
+  ASSERT_TRUE(dir.CreateUniqueTempDir());
+  base::FilePath file = dir.GetPath().Append(FILE_PATH_LITERAL("data.bin"));
+  std::string content;
+  for (int i = 0; i < 100000; ++i)
+    content.push_back(static_cast<char>(i % 251));
+  base::WriteFile(file, content.c_str(), static_cast<int>(content.size()));
+  scoped_refptr<nu::ProtocolFileJob> job(new nu::ProtocolFileJob(file));
+  int content_length = -1;
+  job->Plug([&](int size) { content_length = size; });
+  ASSERT_TRUE(job->Start());
+  EXPECT_EQ(content_length, static_cast<int>(content.size()));
+  std::string result;
+  char buffer[4096];
+  while (size_t nread = job->Read(buffer, sizeof(buffer)))
+    result.append(buffer, nread);
+  EXPECT_EQ(result, content);
+}
+
+TEST_F(BrowserTest, FileJobTruncated) {
+  // Files may be rewritten while being served, which should not crash.
+  base::ScopedTempDir dir;
+  ASSERT_TRUE(dir.CreateUniqueTempDir());
+  base::FilePath file = dir.GetPath().Append(FILE_PATH_LITERAL("data.txt"));
+  std::string content(100000, 'a');
+  base::WriteFile(file, content.c_str(), static_cast<int>(content.size()));
+  scoped_refptr<nu::ProtocolFileJob> job(new nu::ProtocolFileJob(file));
+  job->Plug([](int) {});
+  ASSERT_TRUE(job->Start());
+  base::WriteFile(file, "short", 5);
+  std::string result;
+  char buffer[4096];
+  while (size_t nread = job->Read(buffer, sizeof(buffer)))
+    result.append(buffer, nread);
+  EXPECT_EQ(result, "short");
+}
+
 TEST_F(BrowserTest, LargeFileProtocol) {
   // Serve the pug.js, which should be large enough.
   base::FilePath exe_path;
@@ -408,3 +493,34 @@ TEST_F(BrowserTest, LargeFileProtocol) {
   });
   nu::MessageLoop::Run();
 }
+
+#if defined(OS_LINUX)
+TEST_F(BrowserTest, BinaryChannel) {
+  const char data[] = { 0, 1, 2, '\xFF' };
+  std::vector<char> received;
+  std::function<void(std::vector<char>)> handler =
+      [&](std::vector<char> buffer) {
+    received = std::move(buffer);
+    nu::Browser::UnregisterProtocol("bin");
+    nu::MessageLoop::Quit();
+  };
+  browser_->AddBinding("receive", handler);
+  nu::Browser::RegisterProtocol("bin", [&](const std::string& url) {
+    if (url == "bin://host/data")
+      return static_cast<nu::ProtocolJob*>(new nu::ProtocolBufferJob(
+          "application/octet-stream", nu::Buffer(data, sizeof(data))));
+    return static_cast<nu::ProtocolJob*>(new nu::ProtocolStringJob(
+        "text/html",
+        "<script>"
+        "fetch('bin://host/data')"
+        "  .then((r) => r.arrayBuffer())"
+        "  .then((b) => window.receive(new Uint8Array(b, 1)))"
+        "</script>"));
+  });
+  nu::MessageLoop::PostTask([&]() {
+    browser_->LoadURL("bin://host/index");
+  });
+  nu::MessageLoop::Run();
+  EXPECT_EQ(received, std::vector<char>(data + 1, data + sizeof(data)));
+}
+#endif
@@ -0,0 +1,29 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_BUFFER_H_
+#define NATIVEUI_BUFFER_H_
+
+#include <stddef.h>
+
+namespace nu {
+
+// A view of binary data owned by others, used for passing memory to APIs
+// without copying it. The memory must stay valid while the view is used.
+class Buffer {
+ public:
+  Buffer() {}
+  Buffer(const void* content, size_t size) : content_(content), size_(size) {}
+
+  const void* content() const { return content_; }
+  size_t size() const { return size_; }
+
+ private:
+  const void* content_ = nullptr;
+  size_t size_ = 0;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_BUFFER_H_
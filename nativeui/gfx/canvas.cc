@@ -21,7 +21,22 @@ Canvas::Canvas(const SizeF& size, float scale_factor)
 }
 
 Canvas::~Canvas() {
+  UnlockPixels();
   PlatformDestroyBitmap(bitmap_);
 }
 
+bool Canvas::LockPixels(Pixels* pixels) {
+  if (pixels_locked_ || !PlatformLockPixels(pixels))
+    return false;
+  pixels_locked_ = true;
+  return true;
+}
+
+void Canvas::UnlockPixels() {
+  if (!pixels_locked_)
+    return;
+  PlatformUnlockPixels();
+  pixels_locked_ = false;
+}
+
 }  // namespace nu
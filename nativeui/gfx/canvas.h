@@ -35,6 +35,30 @@ class NATIVEUI_EXPORT Canvas : public base::RefCounted<Canvas> {
   // Return the size of canvas.
   SizeF GetSize() const { return size_; }
 
+  // Describes the pixels of canvas.
+  struct Pixels {
+    // All formats use 32-bit pixels in native endian, so the bytes are in
+    // BGRA order on little endian machines.
+    enum class Format {
+      PremultipliedARGB,  // GTK and macOS
+      ARGB,               // Windows
+    };
+
+    void* data;
+    int width;   // in pixels
+    int height;  // in pixels
+    int stride;  // bytes per row
+    Format format;
+  };
+
+  // Lock the pixels of canvas for reading and writing them directly, the
+  // painter must not be used before UnlockPixels is called. Returns false if
+  // the pixels are already locked or it fails.
+  bool LockPixels(Pixels* pixels);
+
+  // Commit the changes to pixels.
+  void UnlockPixels();
+
   // Internal: Return the native bitmap object.
   NativeBitmap GetBitmap() const { return bitmap_; }
 
@@ -50,12 +74,19 @@ class NATIVEUI_EXPORT Canvas : public base::RefCounted<Canvas> {
   static void PlatformDestroyBitmap(NativeBitmap bitmap);
   static Painter* PlatformCreatePainter(NativeBitmap bitmap,
                                         float scale_factor);
+  bool PlatformLockPixels(Pixels* pixels);
+  void PlatformUnlockPixels();
 
   float scale_factor_;
   SizeF size_;
 
   NativeBitmap bitmap_;
   std::unique_ptr<Painter> painter_;
+
+  bool pixels_locked_ = false;
+#if defined(OS_WIN)
+  Gdiplus::BitmapData* lock_data_ = nullptr;
+#endif
 };
 
 }  // namespace nu
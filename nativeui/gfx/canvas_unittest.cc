@@ -0,0 +1,33 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class CanvasTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    canvas_ = new nu::Canvas(nu::SizeF(10, 10), 2.f);
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::Canvas> canvas_;
+};
+
+TEST_F(CanvasTest, LockPixels) {
+  nu::Canvas::Pixels pixels;
+  ASSERT_TRUE(canvas_->LockPixels(&pixels));
+  EXPECT_EQ(pixels.width, 20);
+  EXPECT_EQ(pixels.height, 20);
+  EXPECT_GE(pixels.stride, pixels.width * 4);
+  // Can not lock twice.
+  nu::Canvas::Pixels again;
+  EXPECT_FALSE(canvas_->LockPixels(&again));
+  static_cast<uint32_t*>(pixels.data)[0] = 0xFFFF0000;
+  canvas_->UnlockPixels();
+  ASSERT_TRUE(canvas_->LockPixels(&pixels));
+  EXPECT_EQ(static_cast<uint32_t*>(pixels.data)[0], 0xFFFF0000);
+  canvas_->UnlockPixels();
+}
@@ -0,0 +1,76 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/font.h"
+
+#include <map>
+#include <tuple>
+#include <unordered_map>
+
+#include "base/lazy_instance.h"
+
+namespace nu {
+
+namespace {
+
+using FontKey = std::tuple<std::string, float, Font::Weight, Font::Style>;
+
+// The cache does not own fonts, and a font removes itself from the cache when
+// it is destroyed.
+struct FontCache {
+  std::map<FontKey, Font*> fonts;
+  std::unordered_map<const Font*, FontKey> keys;
+};
+
+base::LazyInstance<FontCache>::Leaky g_font_cache = LAZY_INSTANCE_INITIALIZER;
+
+// Return the cached font of |key|, or null if there is none.
+Font* Lookup(const FontKey& key) {
+  FontCache& cache = g_font_cache.Get();
+  auto it = cache.fonts.find(key);
+  return it == cache.fonts.end() ? nullptr : it->second;
+}
+
+void Insert(const FontKey& key, Font* font) {
+  FontCache& cache = g_font_cache.Get();
+  cache.fonts[key] = font;
+  cache.keys[font] = key;
+}
+
+}  // namespace
+
+// static
+scoped_refptr<Font> Font::Get(const std::string& name, float size,
+                              Weight weight, Style style) {
+  FontKey key(name, size, weight, style);
+  Font* font = Lookup(key);
+  if (font)
+    return font;
+  font = new Font(name, size, weight, style);
+  Insert(key, font);
+  return font;
+}
+
+// static
+scoped_refptr<Font> Font::Intern(Font* font) {
+  scoped_refptr<Font> ref(font);
+  FontKey key(font->GetName(), font->GetSize(), font->GetWeight(),
+              font->GetStyle());
+  Font* cached = Lookup(key);
+  if (cached)
+    return cached;
+  Insert(key, font);
+  return ref;
+}
+
+void Font::Uncache() {
+  FontCache& cache = g_font_cache.Get();
+  auto it = cache.keys.find(this);
+  if (it == cache.keys.end())
+    return;
+  cache.fonts.erase(it->second);
+  cache.keys.erase(it);
+}
+
+}  // namespace nu
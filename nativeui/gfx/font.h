@@ -41,6 +41,11 @@ class NATIVEUI_EXPORT Font : public base::RefCounted<Font> {
   // (encoded in UTF-8), DIP |size|, |weight| and |style|.
   Font(const std::string& name, float size, Weight weight, Style style);
 
+  // Like the constructor, but return the existing font when there is one
+  // created by this method with the same arguments and still alive.
+  static scoped_refptr<Font> Get(const std::string& name, float size,
+                                 Weight weight, Style style);
+
   // Return the specified font name in UTF-8.
   std::string GetName() const;
 
@@ -60,8 +65,16 @@ class NATIVEUI_EXPORT Font : public base::RefCounted<Font> {
   virtual ~Font();
 
  private:
+  friend class App;
   friend class base::RefCounted<Font>;
 
+  // Return the cached font with the same attributes of |font|, or put |font|
+  // in the cache if there is none.
+  static scoped_refptr<Font> Intern(Font* font);
+
+  // Remove the font from the cache, called when the font is destroyed.
+  void Uncache();
+
   NativeFont font_;
 };
 
@@ -0,0 +1,29 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class FontTest : public testing::Test {
+ protected:
+  nu::Lifetime lifetime_;
+  nu::State state_;
+};
+
+TEST_F(FontTest, Get) {
+  scoped_refptr<nu::Font> font = nu::Font::Get(
+      "Arial", 12, nu::Font::Weight::Bold, nu::Font::Style::Normal);
+  // The cache does not keep fonts alive.
+  EXPECT_TRUE(font->HasOneRef());
+  EXPECT_EQ(font, nu::Font::Get("Arial", 12, nu::Font::Weight::Bold,
+                                nu::Font::Style::Normal));
+  EXPECT_NE(font, nu::Font::Get("Arial", 13, nu::Font::Weight::Bold,
+                                nu::Font::Style::Normal));
+}
+
+TEST_F(FontTest, DefaultFont) {
+  nu::Font* font = nu::App::GetCurrent()->GetDefaultFont();
+  EXPECT_EQ(font, nu::Font::Get(font->GetName(), font->GetSize(),
+                                font->GetWeight(), font->GetStyle()));
+}
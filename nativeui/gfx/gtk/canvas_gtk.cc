@@ -30,4 +30,22 @@ Painter* Canvas::PlatformCreatePainter(NativeBitmap bitmap,
   return new PainterGtk(bitmap, scale_factor);
 }
 
+bool Canvas::PlatformLockPixels(Pixels* pixels) {
+  // Finish pending drawing before touching the pixels.
+  cairo_surface_flush(bitmap_);
+  pixels->data = cairo_image_surface_get_data(bitmap_);
+  if (!pixels->data)
+    return false;
+  pixels->width = cairo_image_surface_get_width(bitmap_);
+  pixels->height = cairo_image_surface_get_height(bitmap_);
+  pixels->stride = cairo_image_surface_get_stride(bitmap_);
+  pixels->format = Pixels::Format::PremultipliedARGB;
+  return true;
+}
+
+void Canvas::PlatformUnlockPixels() {
+  // Tell cairo to drop the caches of the pixels.
+  cairo_surface_mark_dirty(bitmap_);
+}
+
 }  // namespace nu
@@ -35,6 +35,7 @@ Font::Font(const std::string& name, float size, Weight weight, Style style)
 }
 
 Font::~Font() {
+  Uncache();
   pango_font_description_free(font_);
 }
 
@@ -8,20 +8,6 @@
 
 namespace nu {
 
-Image::Image(const base::FilePath& path)
-    : scale_factor_(GetScaleFactorFromFilePath(path)),
-      image_(gdk_pixbuf_new_from_file(path.value().c_str(), nullptr)) {
-  // When file reading failed |image_| could be nullptr, having a null
-  // native image is very dangerous so we create an empty image when it
-  // happens.
-  if (!image_)
-    image_ = gdk_pixbuf_new(GDK_COLORSPACE_RGB, true, 8, 1, 1);
-}
-
-Image::~Image() {
-  g_object_unref(image_);
-}
-
 SizeF Image::GetSize() const {
   return ScaleSize(SizeF(gdk_pixbuf_get_width(image_),
                          gdk_pixbuf_get_height(image_)),
@@ -32,4 +18,69 @@ NativeImage Image::GetNative() const {
   return image_;
 }
 
+cairo_surface_t* Image::GetCairoSurface() {
+  // GdkPixbuf stores non-premultiplied RGBA, converting it for cairo is a
+  // copy of all pixels so only do it once.
+  if (!surface_)
+    surface_ = gdk_cairo_surface_create_from_pixbuf(image_, 1, nullptr);
+  return surface_;
+}
+
+// static
+NativeImage Image::PlatformDecode(const base::FilePath& path,
+                                  const SizeF& max_size,
+                                  float* scale_factor) {
+  *scale_factor = GetScaleFactorFromFilePath(path);
+  const char* filename = path.value().c_str();
+  if (max_size.width() > 0 || max_size.height() > 0) {
+    // Read the size from header and let the loader decode at target size.
+    int width, height;
+    Size target;
+    if (gdk_pixbuf_get_file_info(filename, &width, &height) &&
+        GetScaledDownSize(Size(width, height), *scale_factor, max_size,
+                          &target))
+      return gdk_pixbuf_new_from_file_at_scale(
+          filename, target.width(), target.height(), false, nullptr);
+  }
+  return gdk_pixbuf_new_from_file(filename, nullptr);
+}
+
+// static
+NativeImage Image::PlatformDecodeBuffer(const Buffer& buffer,
+                                        float scale_factor) {
+  GdkPixbufLoader* loader = gdk_pixbuf_loader_new();
+  bool success = gdk_pixbuf_loader_write(
+      loader, static_cast<const guchar*>(buffer.content()), buffer.size(),
+      nullptr);
+  // Closing is required even when writing failed.
+  success = gdk_pixbuf_loader_close(loader, nullptr) && success;
+  GdkPixbuf* pixbuf = success ? gdk_pixbuf_loader_get_pixbuf(loader) : nullptr;
+  if (pixbuf)
+    g_object_ref(pixbuf);
+  g_object_unref(loader);
+  return pixbuf;
+}
+
+// static
+NativeImage Image::PlatformCreateEmpty() {
+  GdkPixbuf* pixbuf = gdk_pixbuf_new(GDK_COLORSPACE_RGB, true, 8, 1, 1);
+  gdk_pixbuf_fill(pixbuf, 0);
+  return pixbuf;
+}
+
+// static
+NativeImage Image::PlatformRetain(NativeImage image) {
+  return static_cast<GdkPixbuf*>(g_object_ref(image));
+}
+
+// static
+void Image::PlatformRelease(NativeImage image) {
+  g_object_unref(image);
+}
+
+// static
+int Image::PlatformGetMemoryUsage(NativeImage image) {
+  return static_cast<int>(gdk_pixbuf_get_byte_length(image));
+}
+
 }  // namespace nu
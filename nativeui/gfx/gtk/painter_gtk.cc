@@ -13,7 +13,9 @@
 
 #include "nativeui/gfx/canvas.h"
 #include "nativeui/gfx/font.h"
+#include "nativeui/gfx/gtk/text_layout_cache_gtk.h"
 #include "nativeui/gfx/image.h"
+#include "nativeui/gfx/path.h"
 
 namespace nu {
 
@@ -126,6 +128,24 @@ void PainterGtk::Fill() {
   cairo_fill(context_);
 }
 
+void PainterGtk::StrokePath(Path* path) {
+  cairo_new_path(context_);
+  cairo_append_path(context_, path->GetNative());
+  Stroke();
+}
+
+void PainterGtk::FillPath(Path* path) {
+  cairo_new_path(context_);
+  cairo_append_path(context_, path->GetNative());
+  Fill();
+}
+
+void PainterGtk::ClipPath(Path* path) {
+  cairo_new_path(context_);
+  cairo_append_path(context_, path->GetNative());
+  cairo_clip(context_);
+}
+
 void PainterGtk::StrokeRect(const RectF& rect) {
   cairo_new_path(context_);
   cairo_rectangle(context_, rect.x(), rect.y(), rect.width(), rect.height());
@@ -160,7 +180,8 @@ void PainterGtk::DrawImageFromRect(Image* image, const RectF& src,
   if (x_scale != 1.0f || y_scale != 1.0f)
     cairo_scale(context_, x_scale, y_scale);
   // Draw.
-  gdk_cairo_set_source_pixbuf(context_, image->GetNative(), -ps.x(), -ps.y());
+  cairo_set_source_surface(context_, image->GetCairoSurface(),
+                           -ps.x(), -ps.y());
   cairo_paint(context_);
   cairo_restore(context_);
 }
@@ -191,11 +212,8 @@ void PainterGtk::DrawCanvasFromRect(Canvas* canvas, const RectF& src,
 
 TextMetrics PainterGtk::MeasureText(const std::string& text, float width,
                                     const TextAttributes& attributes) {
-  PangoLayout* layout = pango_cairo_create_layout(context_);
-  pango_layout_set_font_description(layout, attributes.font->GetNative());
-  pango_layout_set_text(layout, text.data(), text.length());
-  if (width >= 0)
-    pango_layout_set_width(layout, width * PANGO_SCALE);
+  PangoLayout* layout = TextLayoutCache::GetLayout(
+      context_, text, attributes.font.get(), width);
   int bwidth, bheight;
   pango_layout_get_pixel_size(layout, &bwidth, &bheight);
   g_object_unref(layout);
@@ -204,14 +222,13 @@ TextMetrics PainterGtk::MeasureText(const std::string& text, float width,
 
 void PainterGtk::DrawText(const std::string& text, const RectF& rect,
                           const TextAttributes& attributes) {
-  PangoLayout* layout = pango_cairo_create_layout(context_);
-  pango_layout_set_font_description(layout, attributes.font->GetNative());
+  // The layout is shared with MeasureText when measured with same width.
+  PangoLayout* layout = TextLayoutCache::GetLayout(
+      context_, text, attributes.font.get(), rect.width());
   cairo_save(context_);
 
   // Text size.
   int width, height;
-  pango_layout_set_width(layout, rect.width() * PANGO_SCALE);
-  pango_layout_set_text(layout, text.data(), text.length());
   pango_layout_get_pixel_size(layout, &width, &height);
 
   // Horizontal alignment.
@@ -232,10 +249,8 @@ void PainterGtk::DrawText(const std::string& text, const RectF& rect,
   cairo_set_source_rgba(context_, color.r() / 255., color.g() / 255.,
                                   color.b() / 255., color.a() / 255.);
 
-  // Draw text.
+  // Draw text, the layout has been shaped for the state of the cairo context.
   cairo_move_to(context_, bounds.x(), bounds.y());
-  pango_layout_set_width(layout, bounds.width() * PANGO_SCALE);
-  pango_layout_set_height(layout, bounds.height() * PANGO_SCALE);
   pango_cairo_show_layout(context_, layout);
 
   cairo_restore(context_);
@@ -0,0 +1,70 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/path.h"
+
+#include <cairo.h>
+#include <stdlib.h>
+
+#include <algorithm>
+
+namespace nu {
+
+namespace {
+
+// Append an element of |type| with |count| points to |path|, the data is
+// built directly so it can be passed to cairo_append_path without converting.
+void AppendData(cairo_path_t* path, int* capacity,
+                cairo_path_data_type_t type,
+                const PointF* points, int count) {
+  int length = count + 1;
+  if (path->num_data + length > *capacity) {
+    *capacity = std::max(*capacity * 2, path->num_data + length);
+    path->data = static_cast<cairo_path_data_t*>(
+        realloc(path->data, *capacity * sizeof(cairo_path_data_t)));
+  }
+  cairo_path_data_t* data = path->data + path->num_data;
+  data[0].header.type = type;
+  data[0].header.length = length;
+  for (int i = 0; i < count; ++i) {
+    data[i + 1].point.x = points[i].x();
+    data[i + 1].point.y = points[i].y();
+  }
+  path->num_data += length;
+}
+
+}  // namespace
+
+void Path::PlatformInit() {
+  path_ = static_cast<cairo_path_t*>(malloc(sizeof(cairo_path_t)));
+  path_->status = CAIRO_STATUS_SUCCESS;
+  path_->data = nullptr;
+  path_->num_data = 0;
+}
+
+void Path::PlatformDestroy() {
+  free(path_->data);
+  free(path_);
+}
+
+void Path::PlatformMoveTo(const PointF& point) {
+  AppendData(path_, &capacity_, CAIRO_PATH_MOVE_TO, &point, 1);
+}
+
+void Path::PlatformLineTo(const PointF& point) {
+  AppendData(path_, &capacity_, CAIRO_PATH_LINE_TO, &point, 1);
+}
+
+void Path::PlatformBezierCurveTo(const PointF& cp1,
+                                 const PointF& cp2,
+                                 const PointF& ep) {
+  PointF points[] = { cp1, cp2, ep };
+  AppendData(path_, &capacity_, CAIRO_PATH_CURVE_TO, points, 3);
+}
+
+void Path::PlatformClosePath() {
+  AppendData(path_, &capacity_, CAIRO_PATH_CLOSE_PATH, nullptr, 0);
+}
+
+}  // namespace nu
@@ -0,0 +1,184 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/gtk/text_layout_cache_gtk.h"
+
+#include <pango/pangocairo.h>
+
+#include <algorithm>
+#include <list>
+#include <map>
+#include <tuple>
+
+#include "base/lazy_instance.h"
+
+namespace nu {
+
+namespace {
+
+// Large enough to hold all cells of a big table.
+const int kDefaultCapacity = 8192;
+
+// Number of drawing targets to keep contexts for, like windows and canvases
+// with different scale factors.
+const size_t kMaxTargets = 8;
+
+struct Key {
+  std::string text;
+  std::string font;  // serialized font description
+  int width;         // in pango units, -1 for unlimited
+  int target;        // id of the target the layout is shaped for
+
+  bool operator<(const Key& other) const {
+    return std::tie(text, font, width, target) <
+           std::tie(other.text, other.font, other.width, other.target);
+  }
+};
+
+// Layouts are shaped for the font options and transform of cairo contexts,
+// each combination has its own PangoContext. Layouts keep their contexts
+// alive, so a target can be removed while its layouts are still cached.
+struct Target {
+  int id;
+  cairo_font_options_t* font_options;
+  cairo_matrix_t matrix;  // without translation
+  PangoContext* context;
+};
+
+// Most recently used targets are put at front.
+using TargetList = std::list<Target>;
+
+struct Entry {
+  Key key;
+  PangoLayout* layout;
+};
+
+// Most recently used entries are put at front.
+using EntryList = std::list<Entry>;
+
+inline bool IsSameMatrix(const cairo_matrix_t& a, const cairo_matrix_t& b) {
+  return a.xx == b.xx && a.yx == b.yx && a.xy == b.xy && a.yy == b.yy;
+}
+
+struct CacheData {
+  // Return the target matching the state of |cr|, a new one is created when
+  // there is none.
+  const Target& GetTarget(cairo_t* cr) {
+    cairo_matrix_t matrix;
+    cairo_get_matrix(cr, &matrix);
+    // Like pango_cairo_update_context, translation does not affect shaping.
+    matrix.x0 = matrix.y0 = 0;
+    cairo_font_options_t* font_options = cairo_font_options_create();
+    cairo_surface_get_font_options(cairo_get_target(cr), font_options);
+    for (auto it = targets.begin(); it != targets.end(); ++it) {
+      if (IsSameMatrix(it->matrix, matrix) &&
+          cairo_font_options_equal(it->font_options, font_options)) {
+        cairo_font_options_destroy(font_options);
+        targets.splice(targets.begin(), targets, it);
+        return targets.front();
+      }
+    }
+    PangoContext* context = pango_font_map_create_context(
+        pango_cairo_font_map_get_default());
+    pango_cairo_update_context(cr, context);
+    targets.push_front({ ++next_target_id, font_options, matrix, context });
+    if (targets.size() > kMaxTargets) {
+      const Target& target = targets.back();
+      cairo_font_options_destroy(target.font_options);
+      g_object_unref(target.context);
+      targets.pop_back();
+    }
+    return targets.front();
+  }
+
+  // Remove least recently used layouts until there are at most |count| ones.
+  void Evict(int count) {
+    while (!entries.empty() && stats.count > count) {
+      const Entry& entry = entries.back();
+      g_object_unref(entry.layout);
+      stats.count--;
+      stats.evictions++;
+      index.erase(entry.key);
+      entries.pop_back();
+    }
+  }
+
+  TargetList targets;
+  int next_target_id = 0;
+  int capacity = kDefaultCapacity;
+  TextLayoutCache::Stats stats = {0};
+  EntryList entries;
+  std::map<Key, EntryList::iterator> index;
+};
+
+base::LazyInstance<CacheData>::Leaky g_cache = LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+// static
+void TextLayoutCache::SetCapacity(int entries) {
+  CacheData& cache = g_cache.Get();
+  cache.capacity = std::max(entries, 0);
+  cache.Evict(cache.capacity);
+}
+
+// static
+int TextLayoutCache::GetCapacity() {
+  return g_cache.Get().capacity;
+}
+
+// static
+TextLayoutCache::Stats TextLayoutCache::GetStats() {
+  return g_cache.Get().stats;
+}
+
+// static
+void TextLayoutCache::ResetStats() {
+  TextLayoutCache::Stats& stats = g_cache.Get().stats;
+  stats.hits = stats.misses = stats.evictions = 0;
+}
+
+// static
+void TextLayoutCache::Clear() {
+  CacheData& cache = g_cache.Get();
+  for (const Entry& entry : cache.entries)
+    g_object_unref(entry.layout);
+  cache.entries.clear();
+  cache.index.clear();
+  cache.stats.count = 0;
+}
+
+// static
+PangoLayout* TextLayoutCache::GetLayout(cairo_t* cr, const std::string& text,
+                                        Font* font, float width) {
+  CacheData& cache = g_cache.Get();
+  const Target& target = cache.GetTarget(cr);
+  char* font_string = pango_font_description_to_string(font->GetNative());
+  Key key = { text, font_string, width >= 0 ? width * PANGO_SCALE : -1,
+              target.id };
+  g_free(font_string);
+
+  auto it = cache.index.find(key);
+  if (it != cache.index.end()) {
+    cache.stats.hits++;
+    cache.entries.splice(cache.entries.begin(), cache.entries, it->second);
+    return PANGO_LAYOUT(g_object_ref(it->second->layout));
+  }
+
+  cache.stats.misses++;
+  PangoLayout* layout = pango_layout_new(target.context);
+  pango_layout_set_font_description(layout, font->GetNative());
+  pango_layout_set_text(layout, text.data(), text.length());
+  pango_layout_set_width(layout, key.width);
+  if (cache.capacity == 0)
+    return layout;
+
+  cache.Evict(cache.capacity - 1);
+  cache.entries.push_front({ key, PANGO_LAYOUT(g_object_ref(layout)) });
+  cache.index[key] = cache.entries.begin();
+  cache.stats.count++;
+  return layout;
+}
+
+}  // namespace nu
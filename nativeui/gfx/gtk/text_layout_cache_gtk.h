@@ -0,0 +1,57 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_GFX_GTK_TEXT_LAYOUT_CACHE_GTK_H_
+#define NATIVEUI_GFX_GTK_TEXT_LAYOUT_CACHE_GTK_H_
+
+#include <string>
+
+#include "nativeui/gfx/font.h"
+
+typedef struct _cairo cairo_t;
+typedef struct _PangoLayout PangoLayout;
+
+namespace nu {
+
+// A LRU cache of shaped PangoLayouts, which are shared between drawing and
+// measuring text. Layouts are created on one PangoContext for each combination
+// of font options and transform of cairo contexts, so cached layouts never
+// need to be reshaped when used. Must only be used on the GUI thread.
+class NATIVEUI_EXPORT TextLayoutCache {
+ public:
+  struct Stats {
+    int hits;
+    int misses;
+    int evictions;
+    int count;  // number of cached layouts
+  };
+
+  // Change the max number of cached layouts, least recently used layouts are
+  // evicted when it is exceeded. Setting it to 0 disables the cache.
+  static void SetCapacity(int entries);
+  static int GetCapacity();
+
+  // Return the counters and current usage.
+  static Stats GetStats();
+
+  // Reset the hits, misses and evictions counters.
+  static void ResetStats();
+
+  // Remove all cached layouts.
+  static void Clear();
+
+ private:
+  friend class PainterGtk;
+
+  // Return a new reference to the layout of |text| in |font| for drawing on
+  // |cr|, which is wrapped at |width| DIP when it is not negative.
+  static PangoLayout* GetLayout(cairo_t* cr, const std::string& text,
+                                Font* font, float width);
+
+  DISALLOW_IMPLICIT_CONSTRUCTORS(TextLayoutCache);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_GFX_GTK_TEXT_LAYOUT_CACHE_GTK_H_
@@ -0,0 +1,79 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/gtk/text_layout_cache_gtk.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class TextLayoutCacheTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    nu::TextLayoutCache::Clear();
+    nu::TextLayoutCache::ResetStats();
+    canvas_ = new nu::Canvas(nu::SizeF(100, 100));
+  }
+
+  void TearDown() override {
+    nu::TextLayoutCache::SetCapacity(capacity_);
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::Canvas> canvas_;
+  int capacity_ = nu::TextLayoutCache::GetCapacity();
+};
+
+TEST_F(TextLayoutCacheTest, ReuseBetweenMeasureAndDraw) {
+  nu::Painter* painter = canvas_->GetPainter();
+  nu::TextAttributes attributes;
+  nu::TextMetrics metrics = painter->MeasureText("cell", 50, attributes);
+  painter->DrawText("cell", nu::RectF(0, 0, 50, 20), attributes);
+  EXPECT_EQ(painter->MeasureText("cell", 50, attributes).size, metrics.size);
+  nu::TextLayoutCache::Stats stats = nu::TextLayoutCache::GetStats();
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.hits, 2);
+  EXPECT_EQ(stats.count, 1);
+  // Different width is a different layout.
+  painter->MeasureText("cell", -1, attributes);
+  EXPECT_EQ(nu::TextLayoutCache::GetStats().misses, 2);
+}
+
+TEST_F(TextLayoutCacheTest, Evict) {
+  nu::TextLayoutCache::SetCapacity(2);
+  nu::Painter* painter = canvas_->GetPainter();
+  nu::TextAttributes attributes;
+  painter->MeasureText("a", -1, attributes);
+  painter->MeasureText("b", -1, attributes);
+  painter->MeasureText("a", -1, attributes);
+  painter->MeasureText("c", -1, attributes);
+  nu::TextLayoutCache::Stats stats = nu::TextLayoutCache::GetStats();
+  EXPECT_EQ(stats.count, 2);
+  EXPECT_EQ(stats.evictions, 1);
+  // "b" is the least recently used one.
+  painter->MeasureText("a", -1, attributes);
+  EXPECT_EQ(nu::TextLayoutCache::GetStats().hits, 2);
+  nu::TextLayoutCache::SetCapacity(0);
+  EXPECT_EQ(nu::TextLayoutCache::GetStats().count, 0);
+}
+
+TEST_F(TextLayoutCacheTest, SeparateTargets) {
+  // Layouts are shaped for the transform of painter, painters with different
+  // scale factors do not share layouts.
+  scoped_refptr<nu::Canvas> canvas(new nu::Canvas(nu::SizeF(100, 100), 1.f));
+  scoped_refptr<nu::Canvas> canvas2x(new nu::Canvas(nu::SizeF(100, 100), 2.f));
+  nu::Painter* painter = canvas->GetPainter();
+  nu::Painter* painter2x = canvas2x->GetPainter();
+  nu::TextAttributes attributes;
+  nu::TextMetrics metrics = painter->MeasureText("cell", -1, attributes);
+  painter2x->DrawText("cell", nu::RectF(0, 0, 50, 20), attributes);
+  painter2x->MeasureText("cell", -1, attributes);
+  EXPECT_EQ(nu::TextLayoutCache::GetStats().misses, 3);
+  // Alternating between painters reuses the layouts of each one.
+  EXPECT_EQ(painter->MeasureText("cell", -1, attributes).size, metrics.size);
+  painter2x->MeasureText("cell", -1, attributes);
+  nu::TextLayoutCache::Stats stats = nu::TextLayoutCache::GetStats();
+  EXPECT_EQ(stats.misses, 3);
+  EXPECT_EQ(stats.hits, 2);
+  EXPECT_EQ(stats.count, 3);
+}
@@ -4,9 +4,20 @@
 
 #include "nativeui/gfx/image.h"
 
+#include <algorithm>
+#include <memory>
+
 #include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/strings/pattern.h"
 #include "base/strings/string_util.h"
+#include "nativeui/asar_archive.h"
+#include "nativeui/gfx/image_cache.h"
+#include "nativeui/thread_pool.h"
+
+#if defined(OS_LINUX)
+#include <cairo.h>
+#endif
 
 namespace nu {
 
@@ -34,6 +45,90 @@ ScaleFactorPair kScaleFactorPairs[] = {
 
 }  // namespace
 
+Image::Image(const base::FilePath& path) : Image(path, SizeF()) {
+}
+
+Image::Image(const base::FilePath& path, const SizeF& max_size)
+    : scale_factor_(1.f), image_(LoadFile(path, max_size, &scale_factor_)) {
+  // When file reading failed |image_| could be nullptr, having a null
+  // native image is very dangerous so we create an empty image when it
+  // happens.
+  if (!image_)
+    image_ = PlatformCreateEmpty();
+}
+
+Image::Image(NativeImage image, float scale_factor)
+    : scale_factor_(scale_factor), image_(image) {
+}
+
+Image::~Image() {
+#if defined(OS_LINUX)
+  if (surface_)
+    cairo_surface_destroy(surface_);
+#endif
+  PlatformRelease(image_);
+}
+
+// static
+scoped_refptr<Image> Image::CreateFromBuffer(const Buffer& buffer,
+                                             float scale_factor) {
+  NativeImage image = PlatformDecodeBuffer(buffer, scale_factor);
+  if (!image)
+    return nullptr;
+  return new Image(image, scale_factor);
+}
+
+// static
+scoped_refptr<Image> Image::CreateFromAsar(AsarArchive* archive,
+                                           const std::string& path) {
+  base::MemoryMappedFile mapped_file;
+  if (!archive->MapFile(path, &mapped_file))
+    return nullptr;
+  return CreateFromBuffer(
+      Buffer(mapped_file.data(), mapped_file.length()),
+      GetScaleFactorFromFilePath(base::FilePath::FromUTF8Unsafe(path)));
+}
+
+// static
+void Image::LoadAsync(const base::FilePath& path, LoadCallback callback) {
+  LoadAsync(path, SizeF(), std::move(callback));
+}
+
+// static
+void Image::LoadAsync(const base::FilePath& path, const SizeF& max_size,
+                      LoadCallback callback) {
+  // Only the first request of the same file does the loading.
+  ImageCache::Key key = ImageCache::GetKeyForFile(path, max_size);
+  if (!ImageCache::AddPendingLoad(key, std::move(callback)))
+    return;
+  struct Result {
+    NativeImage image = nullptr;
+    float scale_factor = 1.f;
+  };
+  auto result = std::make_shared<Result>();
+  ThreadPool::PostTaskAndReply(
+      [path, max_size, result]() {
+        result->image = LoadFile(path, max_size, &result->scale_factor);
+      },
+      [key, result]() {
+        scoped_refptr<Image> image;
+        if (result->image)
+          image = new Image(result->image, result->scale_factor);
+        for (const auto& callback : ImageCache::TakePendingLoads(key))
+          callback(image);
+      });
+}
+
+// static
+Image* Image::GetPlaceholder() {
+  static Image* placeholder = nullptr;
+  if (!placeholder) {
+    placeholder = new Image(PlatformCreateEmpty(), 1.f);
+    placeholder->AddRef();  // leaked
+  }
+  return placeholder;
+}
+
 // static
 float Image::GetScaleFactorFromFilePath(const base::FilePath& path) {
   base::FilePath::StringType name(path.BaseName().RemoveExtension().value());
@@ -50,4 +145,35 @@ float Image::GetScaleFactorFromFilePath(const base::FilePath& path) {
   return 1.0f;
 }
 
+// static
+bool Image::GetScaledDownSize(const Size& size, float scale_factor,
+                              const SizeF& max_size, Size* result) {
+  if (size.IsEmpty())
+    return false;
+  float ratio = 1.f;
+  if (max_size.width() > 0)
+    ratio = std::min(ratio, max_size.width() * scale_factor / size.width());
+  if (max_size.height() > 0)
+    ratio = std::min(ratio, max_size.height() * scale_factor / size.height());
+  if (ratio >= 1.f)
+    return false;
+  *result = Size(std::max(static_cast<int>(size.width() * ratio + 0.5f), 1),
+                 std::max(static_cast<int>(size.height() * ratio + 0.5f), 1));
+  return true;
+}
+
+// static
+NativeImage Image::LoadFile(const base::FilePath& path,
+                            const SizeF& max_size,
+                            float* scale_factor) {
+  ImageCache::Key key = ImageCache::GetKeyForFile(path, max_size);
+  NativeImage image = nullptr;
+  if (ImageCache::Lookup(key, &image, scale_factor))
+    return image;
+  image = PlatformDecode(path, max_size, scale_factor);
+  if (image)
+    ImageCache::Insert(key, image, *scale_factor);
+  return image;
+}
+
 }  // namespace nu
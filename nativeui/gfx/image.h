@@ -5,19 +5,54 @@
 #ifndef NATIVEUI_GFX_IMAGE_H_
 #define NATIVEUI_GFX_IMAGE_H_
 
+#include <functional>
+#include <string>
+
 #include "base/files/file_path.h"
 #include "base/memory/ref_counted.h"
+#include "nativeui/buffer.h"
+#include "nativeui/gfx/geometry/size.h"
 #include "nativeui/gfx/geometry/size_f.h"
 #include "nativeui/types.h"
 
 namespace nu {
 
+class AsarArchive;
+
 class NATIVEUI_EXPORT Image : public base::RefCounted<Image> {
  public:
+  // Function type for receiving images loaded asynchronously.
+  using LoadCallback = std::function<void(scoped_refptr<Image>)>;
+
   // Create an image by reading from |path|.
   // The @2x suffix in basename will make the image have scale factor.
   explicit Image(const base::FilePath& path);
 
+  // Like above, but the image is scaled down when decoding to fit in
+  // |max_size| DIP, the scale factor is kept. A width or height that is not
+  // positive means no limit in that dimension.
+  Image(const base::FilePath& path, const SizeF& max_size);
+
+  // Create an image by decoding |buffer|, which has the content of an image
+  // file. Returns nullptr when it fails.
+  static scoped_refptr<Image> CreateFromBuffer(const Buffer& buffer,
+                                               float scale_factor);
+
+  // Create an image by decoding the file at |path| in |archive|, the file is
+  // mapped into memory instead of being copied. Like reading from files, the
+  // @2x suffix in basename will make the image have scale factor.
+  static scoped_refptr<Image> CreateFromAsar(AsarArchive* archive,
+                                             const std::string& path);
+
+  // Read and decode the image at |path| on a worker thread, and then pass it
+  // to |callback| on the GUI thread. nullptr is passed when it fails.
+  static void LoadAsync(const base::FilePath& path, LoadCallback callback);
+  static void LoadAsync(const base::FilePath& path, const SizeF& max_size,
+                        LoadCallback callback);
+
+  // Return a shared transparent image that can be shown while loading.
+  static Image* GetPlaceholder();
+
   // Get the size of image.
   SizeF GetSize() const;
 
@@ -27,16 +62,68 @@ class NATIVEUI_EXPORT Image : public base::RefCounted<Image> {
   // Return the native instance of image object.
   NativeImage GetNative() const;
 
+#if defined(OS_LINUX)
+  // Internal: Return a premultiplied cairo surface of the image, it is
+  // created on first use and kept for later drawing.
+  cairo_surface_t* GetCairoSurface();
+#endif
+
  protected:
   virtual ~Image();
 
  private:
   friend class base::RefCounted<Image>;
+  friend class ImageCache;
+
+  // Take the ownership of |image|.
+  Image(NativeImage image, float scale_factor);
 
   static float GetScaleFactorFromFilePath(const base::FilePath& path);
 
+  // Compute the pixel size of an image of |size| pixels scaled down to fit in
+  // |max_size|, returns false if the image already fits.
+  static bool GetScaledDownSize(const Size& size, float scale_factor,
+                                const SizeF& max_size, Size* result);
+
+  // Decode the image at |path| or get it from cache.
+  static NativeImage LoadFile(const base::FilePath& path,
+                              const SizeF& max_size,
+                              float* scale_factor);
+
+  // Decode the image at |path| to fit in |max_size|, returns nullptr when it
+  // fails. This may be called on worker threads.
+  static NativeImage PlatformDecode(const base::FilePath& path,
+                                    const SizeF& max_size,
+                                    float* scale_factor);
+
+#if defined(OS_MACOSX)
+  // Decode at target size with ImageIO, returns nil if not needed.
+  static NSImage* DecodeThumbnail(const base::FilePath& path,
+                                  const SizeF& max_size,
+                                  float* scale_factor);
+#endif
+
+  // Decode the image file content in |buffer|, returns nullptr when it fails.
+  // The |buffer| is not referenced after returning.
+  static NativeImage PlatformDecodeBuffer(const Buffer& buffer,
+                                          float scale_factor);
+
+  // Create a transparent native image.
+  static NativeImage PlatformCreateEmpty();
+
+  // Add and remove a reference to the shared |image|.
+  static NativeImage PlatformRetain(NativeImage image);
+  static void PlatformRelease(NativeImage image);
+
+  // Return the bytes used by the pixels of |image|.
+  static int PlatformGetMemoryUsage(NativeImage image);
+
   float scale_factor_;
   NativeImage image_;
+
+#if defined(OS_LINUX)
+  cairo_surface_t* surface_ = nullptr;
+#endif
 };
 
 }  // namespace nu
@@ -0,0 +1,188 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/image_cache.h"
+
+#include <algorithm>
+#include <list>
+#include <map>
+#include <tuple>
+#include <utility>
+
+#include "base/files/file_util.h"
+#include "base/lazy_instance.h"
+#include "base/synchronization/lock.h"
+
+namespace nu {
+
+namespace {
+
+const int kDefaultCapacity = 32 * 1024 * 1024;
+
+struct Entry {
+  ImageCache::Key key;
+  NativeImage image;
+  float scale_factor;
+  int memory_usage;
+};
+
+// Most recently used entries are put at front.
+using EntryList = std::list<Entry>;
+
+struct CacheData {
+  base::Lock lock;
+  int capacity = kDefaultCapacity;
+  ImageCache::Stats stats = {0};
+  EntryList entries;
+  std::map<ImageCache::Key, EntryList::iterator> index;
+  std::map<ImageCache::Key, std::vector<Image::LoadCallback>> pending_loads;
+};
+
+base::LazyInstance<CacheData>::Leaky g_cache = LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+bool ImageCache::Key::operator<(const Key& other) const {
+  float width = max_size.width(), height = max_size.height();
+  float other_width = other.max_size.width();
+  float other_height = other.max_size.height();
+  return std::tie(path, last_modified, size, scale_factor, width, height) <
+         std::tie(other.path, other.last_modified, other.size,
+                  other.scale_factor, other_width, other_height);
+}
+
+// static
+void ImageCache::SetCapacity(int bytes) {
+  CacheData& cache = g_cache.Get();
+  base::AutoLock auto_lock(cache.lock);
+  cache.capacity = std::max(bytes, 0);
+  Evict(cache.capacity);
+}
+
+// static
+int ImageCache::GetCapacity() {
+  CacheData& cache = g_cache.Get();
+  base::AutoLock auto_lock(cache.lock);
+  return cache.capacity;
+}
+
+// static
+ImageCache::Stats ImageCache::GetStats() {
+  CacheData& cache = g_cache.Get();
+  base::AutoLock auto_lock(cache.lock);
+  return cache.stats;
+}
+
+// static
+void ImageCache::ResetStats() {
+  CacheData& cache = g_cache.Get();
+  base::AutoLock auto_lock(cache.lock);
+  cache.stats.hits = cache.stats.misses = cache.stats.evictions = 0;
+}
+
+// static
+void ImageCache::Clear() {
+  CacheData& cache = g_cache.Get();
+  base::AutoLock auto_lock(cache.lock);
+  for (const Entry& entry : cache.entries)
+    Image::PlatformRelease(entry.image);
+  cache.entries.clear();
+  cache.index.clear();
+  cache.stats.count = cache.stats.memory_usage = 0;
+}
+
+// static
+ImageCache::Key ImageCache::GetKeyForFile(const base::FilePath& path,
+                                          const SizeF& max_size) {
+  base::FilePath canonical = base::MakeAbsoluteFilePath(path);
+  base::File::Info info;
+  if (!base::GetFileInfo(path, &info))
+    info.size = -1;
+  return { canonical.empty() ? path : canonical,
+           info.last_modified,
+           info.size,
+           Image::GetScaleFactorFromFilePath(path),
+           max_size };
+}
+
+// static
+bool ImageCache::Lookup(const Key& key, NativeImage* image,
+                        float* scale_factor) {
+  CacheData& cache = g_cache.Get();
+  base::AutoLock auto_lock(cache.lock);
+  auto it = cache.index.find(key);
+  if (it == cache.index.end()) {
+    cache.stats.misses++;
+    return false;
+  }
+  cache.stats.hits++;
+  cache.entries.splice(cache.entries.begin(), cache.entries, it->second);
+  *image = Image::PlatformRetain(it->second->image);
+  *scale_factor = it->second->scale_factor;
+  return true;
+}
+
+// static
+void ImageCache::Insert(const Key& key, NativeImage image,
+                        float scale_factor) {
+  CacheData& cache = g_cache.Get();
+  base::AutoLock auto_lock(cache.lock);
+  int memory_usage = Image::PlatformGetMemoryUsage(image);
+  // Images larger than the whole budget would evict everything else.
+  if (memory_usage > cache.capacity)
+    return;
+  auto it = cache.index.find(key);
+  if (it != cache.index.end()) {
+    // Loaded by others in the meanwhile, keep the existing one.
+    cache.entries.splice(cache.entries.begin(), cache.entries, it->second);
+    return;
+  }
+  Evict(cache.capacity - memory_usage);
+  cache.entries.push_front(
+      { key, Image::PlatformRetain(image), scale_factor, memory_usage });
+  cache.index[key] = cache.entries.begin();
+  cache.stats.count++;
+  cache.stats.memory_usage += memory_usage;
+}
+
+// static
+bool ImageCache::AddPendingLoad(const Key& key,
+                                Image::LoadCallback callback) {
+  CacheData& cache = g_cache.Get();
+  base::AutoLock auto_lock(cache.lock);
+  std::vector<Image::LoadCallback>& callbacks = cache.pending_loads[key];
+  callbacks.push_back(std::move(callback));
+  return callbacks.size() == 1;
+}
+
+// static
+std::vector<Image::LoadCallback> ImageCache::TakePendingLoads(
+    const Key& key) {
+  CacheData& cache = g_cache.Get();
+  base::AutoLock auto_lock(cache.lock);
+  std::vector<Image::LoadCallback> callbacks;
+  auto it = cache.pending_loads.find(key);
+  if (it != cache.pending_loads.end()) {
+    callbacks = std::move(it->second);
+    cache.pending_loads.erase(it);
+  }
+  return callbacks;
+}
+
+// static
+void ImageCache::Evict(int memory_usage) {
+  CacheData& cache = g_cache.Get();
+  cache.lock.AssertAcquired();
+  while (!cache.entries.empty() && cache.stats.memory_usage > memory_usage) {
+    const Entry& entry = cache.entries.back();
+    Image::PlatformRelease(entry.image);
+    cache.stats.count--;
+    cache.stats.memory_usage -= entry.memory_usage;
+    cache.stats.evictions++;
+    cache.index.erase(entry.key);
+    cache.entries.pop_back();
+  }
+}
+
+}  // namespace nu
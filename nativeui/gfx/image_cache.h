@@ -0,0 +1,82 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_GFX_IMAGE_CACHE_H_
+#define NATIVEUI_GFX_IMAGE_CACHE_H_
+
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/time/time.h"
+#include "nativeui/gfx/image.h"
+
+namespace nu {
+
+// A process-wide LRU cache of decoded images, images created from the same
+// file share the decoded pixels. All methods are thread-safe.
+class NATIVEUI_EXPORT ImageCache {
+ public:
+  // Identifies a decoded image.
+  struct Key {
+    base::FilePath path;       // canonical path
+    base::Time last_modified;  // so modified files are decoded again
+    int64_t size;
+    float scale_factor;
+    SizeF max_size;            // empty for full size
+
+    bool operator<(const Key& other) const;
+  };
+
+  struct Stats {
+    int hits;
+    int misses;
+    int evictions;
+    int count;         // number of cached images
+    int memory_usage;  // bytes used by cached images
+  };
+
+  // Change the memory budget in bytes, least recently used images are evicted
+  // when it is exceeded. Setting it to 0 disables the cache.
+  static void SetCapacity(int bytes);
+  static int GetCapacity();
+
+  // Return the counters and current usage.
+  static Stats GetStats();
+
+  // Reset the hits, misses and evictions counters.
+  static void ResetStats();
+
+  // Remove all cached images, images being used are not affected.
+  static void Clear();
+
+ private:
+  friend class Image;
+
+  // Return the key for the file at |path|, the path is resolved and the file
+  // info is read on disk, a changed file gets a different key.
+  static Key GetKeyForFile(const base::FilePath& path, const SizeF& max_size);
+
+  // Return a new reference to the cached image.
+  static bool Lookup(const Key& key, NativeImage* image, float* scale_factor);
+
+  // Cache a new reference to |image|.
+  static void Insert(const Key& key, NativeImage image, float scale_factor);
+
+  // Queue |callback| for the load of |key|, returns true if it is the first
+  // one and the caller should start loading. Only used on the GUI thread.
+  static bool AddPendingLoad(const Key& key, Image::LoadCallback callback);
+
+  // Remove and return the callbacks queued for |key|.
+  static std::vector<Image::LoadCallback> TakePendingLoads(const Key& key);
+
+  // Evict least recently used images until the memory usage is no more than
+  // |memory_usage|, must be called with lock held.
+  static void Evict(int memory_usage);
+
+  DISALLOW_IMPLICIT_CONSTRUCTORS(ImageCache);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_GFX_IMAGE_CACHE_H_
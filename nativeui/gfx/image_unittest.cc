@@ -0,0 +1,164 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// A 1x1 transparent PNG.
+const unsigned char kPNG[] = {
+  0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d,
+  0x49, 0x48, 0x44, 0x52, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01,
+  0x08, 0x06, 0x00, 0x00, 0x00, 0x1f, 0x15, 0xc4, 0x89, 0x00, 0x00, 0x00,
+  0x0b, 0x49, 0x44, 0x41, 0x54, 0x78, 0x9c, 0x63, 0x60, 0x00, 0x02, 0x00,
+  0x00, 0x05, 0x00, 0x01, 0x7a, 0x5e, 0xab, 0x3f, 0x00, 0x00, 0x00, 0x00,
+  0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82,
+};
+
+// A 64x32 red PNG.
+const unsigned char kLargePNG[] = {
+  0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d,
+  0x49, 0x48, 0x44, 0x52, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x20,
+  0x08, 0x06, 0x00, 0x00, 0x00, 0xa2, 0x9d, 0x7e, 0x84, 0x00, 0x00, 0x00,
+  0x3d, 0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0xed, 0xd0, 0x31, 0x01, 0x00,
+  0x00, 0x08, 0xc0, 0xa0, 0xf5, 0x2f, 0xad, 0x3d, 0x94, 0x83, 0x02, 0x34,
+  0x35, 0x9f, 0x25, 0x40, 0x80, 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20,
+  0x40, 0x80, 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00,
+  0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00, 0x01, 0x02, 0x04,
+  0xdc, 0xb7, 0x20, 0xf2, 0xf0, 0xe2, 0x6e, 0x5c, 0x51, 0x71, 0x00, 0x00,
+  0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82,
+};
+
+}  // namespace
+
+class ImageTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    path_ = temp_dir_.GetPath().Append(FILE_PATH_LITERAL("icon@2x.png"));
+    ASSERT_EQ(base::WriteFile(path_, reinterpret_cast<const char*>(kPNG),
+                              sizeof(kPNG)),
+              static_cast<int>(sizeof(kPNG)));
+    nu::ImageCache::Clear();
+    nu::ImageCache::ResetStats();
+  }
+
+  base::ScopedTempDir temp_dir_;
+  base::FilePath path_;
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+};
+
+TEST_F(ImageTest, LoadAsyncFailure) {
+  bool called = false;
+  nu::Image::LoadAsync(base::FilePath(FILE_PATH_LITERAL("not-exist@2x.png")),
+                       [&](scoped_refptr<nu::Image> image) {
+    called = true;
+    EXPECT_EQ(image.get(), nullptr);
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+  EXPECT_TRUE(called);
+}
+
+TEST_F(ImageTest, Placeholder) {
+  nu::Image* placeholder = nu::Image::GetPlaceholder();
+  EXPECT_EQ(placeholder, nu::Image::GetPlaceholder());
+  EXPECT_EQ(placeholder->GetScaleFactor(), 1.f);
+  EXPECT_EQ(placeholder->GetSize(), nu::SizeF(1, 1));
+}
+
+TEST_F(ImageTest, LoadAsync) {
+  scoped_refptr<nu::Image> first, second;
+  nu::Image::LoadAsync(path_, [&](scoped_refptr<nu::Image> image) {
+    first = image;
+  });
+  // Loads of the same file are merged.
+  nu::Image::LoadAsync(path_, [&](scoped_refptr<nu::Image> image) {
+    second = image;
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+  ASSERT_TRUE(first);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(first->GetScaleFactor(), 2.f);
+  EXPECT_EQ(nu::ImageCache::GetStats().misses, 1);
+}
+
+TEST_F(ImageTest, Cache) {
+  scoped_refptr<nu::Image> first(new nu::Image(path_));
+  scoped_refptr<nu::Image> second(new nu::Image(path_));
+  EXPECT_EQ(second->GetScaleFactor(), 2.f);
+  nu::ImageCache::Stats stats = nu::ImageCache::GetStats();
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.count, 1);
+  EXPECT_GT(stats.memory_usage, 0);
+  int capacity = nu::ImageCache::GetCapacity();
+  nu::ImageCache::SetCapacity(0);
+  stats = nu::ImageCache::GetStats();
+  EXPECT_EQ(stats.evictions, 1);
+  EXPECT_EQ(stats.count, 0);
+  EXPECT_EQ(stats.memory_usage, 0);
+  // Evicting does not affect existing images.
+  EXPECT_EQ(first->GetSize(), second->GetSize());
+  nu::ImageCache::SetCapacity(capacity);
+}
+
+TEST_F(ImageTest, CacheModifiedFile) {
+  scoped_refptr<nu::Image> first(new nu::Image(path_));
+  EXPECT_EQ(first->GetSize(), nu::SizeF(0.5, 0.5));
+  ASSERT_EQ(base::WriteFile(path_, reinterpret_cast<const char*>(kLargePNG),
+                            sizeof(kLargePNG)),
+            static_cast<int>(sizeof(kLargePNG)));
+  // The changed file is not served from cache.
+  scoped_refptr<nu::Image> second(new nu::Image(path_));
+  EXPECT_EQ(second->GetSize(), nu::SizeF(32, 16));
+  EXPECT_EQ(nu::ImageCache::GetStats().misses, 2);
+  EXPECT_EQ(nu::ImageCache::GetStats().hits, 0);
+}
+
+TEST_F(ImageTest, MaxSize) {
+  scoped_refptr<nu::Image> full(new nu::Image(path_));
+  // Images are never scaled up.
+  scoped_refptr<nu::Image> thumbnail(
+      new nu::Image(path_, nu::SizeF(100, 100)));
+  EXPECT_EQ(thumbnail->GetSize(), full->GetSize());
+  EXPECT_EQ(thumbnail->GetScaleFactor(), 2.f);
+  // Different max sizes are cached separately.
+  EXPECT_EQ(nu::ImageCache::GetStats().misses, 2);
+  EXPECT_EQ(nu::ImageCache::GetStats().count, 2);
+}
+
+TEST_F(ImageTest, MaxSizeScaleDown) {
+  base::FilePath path =
+      temp_dir_.GetPath().Append(FILE_PATH_LITERAL("large@2x.png"));
+  ASSERT_EQ(base::WriteFile(path, reinterpret_cast<const char*>(kLargePNG),
+                            sizeof(kLargePNG)),
+            static_cast<int>(sizeof(kLargePNG)));
+  scoped_refptr<nu::Image> full(new nu::Image(path));
+  EXPECT_EQ(full->GetSize(), nu::SizeF(32, 16));
+  int full_memory = nu::ImageCache::GetStats().memory_usage;
+  EXPECT_EQ(full_memory, 64 * 32 * 4);
+  // The 32x16 DIP image fits in 8x8 DIP as 8x4 DIP, which is 16x8 pixels.
+  scoped_refptr<nu::Image> thumbnail(new nu::Image(path, nu::SizeF(8, 8)));
+  EXPECT_EQ(thumbnail->GetSize(), nu::SizeF(8, 4));
+  EXPECT_EQ(thumbnail->GetScaleFactor(), 2.f);
+  // The pixels are decoded at the capped size.
+  EXPECT_EQ(nu::ImageCache::GetStats().memory_usage - full_memory,
+            16 * 8 * 4);
+}
+
+TEST_F(ImageTest, CreateFromBuffer) {
+  scoped_refptr<nu::Image> image = nu::Image::CreateFromBuffer(
+      nu::Buffer(kPNG, sizeof(kPNG)), 2.f);
+  ASSERT_TRUE(image);
+  EXPECT_EQ(image->GetScaleFactor(), 2.f);
+  EXPECT_EQ(image->GetSize(), nu::SizeF(0.5, 0.5));
+  EXPECT_FALSE(nu::Image::CreateFromBuffer(nu::Buffer(kPNG, 8), 1.f));
+}
@@ -38,4 +38,21 @@ Painter* Canvas::PlatformCreatePainter(NativeBitmap bitmap,
   return new PainterMac(bitmap, scale_factor);
 }
 
+bool Canvas::PlatformLockPixels(Pixels* pixels) {
+  // Finish pending drawing before touching the pixels.
+  CGContextFlush(bitmap_);
+  pixels->data = CGBitmapContextGetData(bitmap_);
+  if (!pixels->data)
+    return false;
+  pixels->width = static_cast<int>(CGBitmapContextGetWidth(bitmap_));
+  pixels->height = static_cast<int>(CGBitmapContextGetHeight(bitmap_));
+  pixels->stride = static_cast<int>(CGBitmapContextGetBytesPerRow(bitmap_));
+  pixels->format = Pixels::Format::PremultipliedARGB;
+  return true;
+}
+
+void Canvas::PlatformUnlockPixels() {
+  // The bitmap context draws into the memory directly.
+}
+
 }  // namespace nu
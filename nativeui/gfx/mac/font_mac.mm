@@ -106,6 +106,7 @@ Font::Font(const std::string& name, float size, Weight weight, Style style)
     : font_([NSFontWithSpec(name, size, weight, style) retain]) {}
 
 Font::~Font() {
+  Uncache();
   [font_ release];
 }
 
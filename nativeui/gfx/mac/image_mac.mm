@@ -5,44 +5,139 @@
 #include "nativeui/gfx/image.h"
 
 #import <Cocoa/Cocoa.h>
+#import <ImageIO/ImageIO.h>
 
+#include <algorithm>
+
+#include "base/mac/foundation_util.h"
+#include "base/mac/scoped_cftyperef.h"
+#include "base/mac/scoped_nsautorelease_pool.h"
 #include "base/strings/sys_string_conversions.h"
 
 namespace nu {
 
-Image::Image(const base::FilePath& p)
-    : scale_factor_(1.f),
-      image_([[NSImage alloc]
-                 initWithContentsOfFile:base::SysUTF8ToNSString(p.value())]) {
+SizeF Image::GetSize() const {
+  return SizeF([image_ size]);
+}
+
+NativeImage Image::GetNative() const {
+  return image_;
+}
+
+// static
+NativeImage Image::PlatformDecode(const base::FilePath& p,
+                                  const SizeF& max_size,
+                                  float* scale_factor) {
+  // Worker threads do not have autorelease pools.
+  base::mac::ScopedNSAutoreleasePool autorelease_pool;
+  if (max_size.width() > 0 || max_size.height() > 0) {
+    NSImage* image = DecodeThumbnail(p, max_size, scale_factor);
+    if (image)
+      return image;
+  }
+  NSImage* image = [[NSImage alloc]
+      initWithContentsOfFile:base::SysUTF8ToNSString(p.value())];
+  if (!image)
+    return nil;
   // Compute the scale factor from actual NSImageRep.
-  NSArray* reps = [image_ representations];
+  *scale_factor = 1.f;
+  NSArray* reps = [image representations];
   if ([reps count] > 0) {
-    float lw = [image_ size].width;
+    float lw = [image size].width;
     float pw = [static_cast<NSImageRep*>([reps objectAtIndex:0]) pixelsWide];
     if (lw > 0 && pw > 0)
-      scale_factor_ = pw / lw;
+      *scale_factor = pw / lw;
     // NSImage caculates the DPI from the image automatically, which may not be
     // the same with the DPI set by the @2x suffix, in this case we need to set
     // size of NSImage to match the scale factor.
     float expected = GetScaleFactorFromFilePath(p);
-    if (scale_factor_ != expected) {
+    if (*scale_factor != expected) {
       float ph = [static_cast<NSImageRep*>([reps objectAtIndex:0]) pixelsHigh];
-      [image_ setSize:NSMakeSize(pw / expected, ph / expected)];
-      scale_factor_ = expected;
+      [image setSize:NSMakeSize(pw / expected, ph / expected)];
+      *scale_factor = expected;
     }
   }
+  return image;
 }
 
-Image::~Image() {
-  [image_ release];
+// static
+NSImage* Image::DecodeThumbnail(const base::FilePath& p,
+                                const SizeF& max_size,
+                                float* scale_factor) {
+  NSURL* url = [NSURL fileURLWithPath:base::SysUTF8ToNSString(p.value())];
+  base::ScopedCFTypeRef<CGImageSourceRef> source(
+      CGImageSourceCreateWithURL(base::mac::NSToCFCast(url), nullptr));
+  if (!source)
+    return nil;
+  base::ScopedCFTypeRef<CFDictionaryRef> properties(
+      CGImageSourceCopyPropertiesAtIndex(source, 0, nullptr));
+  if (!properties)
+    return nil;
+  NSDictionary* dict = base::mac::CFToNSCast(properties.get());
+  int width = [dict[base::mac::CFToNSCast(kCGImagePropertyPixelWidth)]
+                  intValue];
+  int height = [dict[base::mac::CFToNSCast(kCGImagePropertyPixelHeight)]
+                   intValue];
+  float expected = GetScaleFactorFromFilePath(p);
+  Size target;
+  if (!GetScaledDownSize(Size(width, height), expected, max_size, &target))
+    return nil;
+  // Let ImageIO decode at target size.
+  NSDictionary* options = @{
+    base::mac::CFToNSCast(kCGImageSourceCreateThumbnailFromImageAlways) : @YES,
+    base::mac::CFToNSCast(kCGImageSourceCreateThumbnailWithTransform) : @YES,
+    base::mac::CFToNSCast(kCGImageSourceThumbnailMaxPixelSize) :
+        @(std::max(target.width(), target.height())),
+  };
+  base::ScopedCFTypeRef<CGImageRef> thumbnail(
+      CGImageSourceCreateThumbnailAtIndex(source, 0,
+                                          base::mac::NSToCFCast(options)));
+  if (!thumbnail)
+    return nil;
+  *scale_factor = expected;
+  NSSize size = NSMakeSize(CGImageGetWidth(thumbnail) / expected,
+                           CGImageGetHeight(thumbnail) / expected);
+  return [[NSImage alloc] initWithCGImage:thumbnail size:size];
 }
 
-SizeF Image::GetSize() const {
-  return SizeF([image_ size]);
+// static
+NativeImage Image::PlatformDecodeBuffer(const Buffer& buffer,
+                                        float scale_factor) {
+  // NSImage may decode lazily, so the data must be copied.
+  NSData* data = [NSData dataWithBytes:buffer.content() length:buffer.size()];
+  NSImage* image = [[NSImage alloc] initWithData:data];
+  if (!image)
+    return nil;
+  NSArray* reps = [image representations];
+  if ([reps count] > 0) {
+    NSImageRep* rep = static_cast<NSImageRep*>([reps objectAtIndex:0]);
+    [image setSize:NSMakeSize([rep pixelsWide] / scale_factor,
+                              [rep pixelsHigh] / scale_factor)];
+  }
+  return image;
 }
 
-NativeImage Image::GetNative() const {
-  return image_;
+// static
+NativeImage Image::PlatformCreateEmpty() {
+  return [[NSImage alloc] initWithSize:NSMakeSize(1, 1)];
+}
+
+// static
+NativeImage Image::PlatformRetain(NativeImage image) {
+  return [image retain];
+}
+
+// static
+void Image::PlatformRelease(NativeImage image) {
+  [image release];
+}
+
+// static
+int Image::PlatformGetMemoryUsage(NativeImage image) {
+  int memory_usage = 0;
+  for (NSImageRep* rep in [image representations])
+    memory_usage += [rep pixelsWide] * [rep pixelsHigh] * 4;
+  return memory_usage;
 }
 
 }  // namespace nu
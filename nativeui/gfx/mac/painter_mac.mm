@@ -13,6 +13,7 @@
 #include "nativeui/gfx/font.h"
 #include "nativeui/gfx/image.h"
 #include "nativeui/gfx/mac/text_mac.h"
+#include "nativeui/gfx/path.h"
 
 namespace nu {
 
@@ -161,6 +162,24 @@ void PainterMac::Fill() {
   CGContextFillPath(context_);
 }
 
+void PainterMac::StrokePath(Path* path) {
+  CGContextBeginPath(context_);
+  CGContextAddPath(context_, path->GetNative());
+  CGContextStrokePath(context_);
+}
+
+void PainterMac::FillPath(Path* path) {
+  CGContextBeginPath(context_);
+  CGContextAddPath(context_, path->GetNative());
+  CGContextFillPath(context_);
+}
+
+void PainterMac::ClipPath(Path* path) {
+  CGContextBeginPath(context_);
+  CGContextAddPath(context_, path->GetNative());
+  CGContextClip(context_);
+}
+
 void PainterMac::StrokeRect(const RectF& rect) {
   CGContextStrokeRect(context_, rect.ToCGRect());
 }
@@ -0,0 +1,38 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/path.h"
+
+#import <CoreGraphics/CoreGraphics.h>
+
+namespace nu {
+
+void Path::PlatformInit() {
+  path_ = CGPathCreateMutable();
+}
+
+void Path::PlatformDestroy() {
+  CGPathRelease(path_);
+}
+
+void Path::PlatformMoveTo(const PointF& point) {
+  CGPathMoveToPoint(path_, nullptr, point.x(), point.y());
+}
+
+void Path::PlatformLineTo(const PointF& point) {
+  CGPathAddLineToPoint(path_, nullptr, point.x(), point.y());
+}
+
+void Path::PlatformBezierCurveTo(const PointF& cp1,
+                                 const PointF& cp2,
+                                 const PointF& ep) {
+  CGPathAddCurveToPoint(path_, nullptr, cp1.x(), cp1.y(), cp2.x(), cp2.y(),
+                        ep.x(), ep.y());
+}
+
+void Path::PlatformClosePath() {
+  CGPathCloseSubpath(path_);
+}
+
+}  // namespace nu
@@ -4,10 +4,195 @@
 
 #include "nativeui/gfx/painter.h"
 
+#include <string.h>
+
+#include "base/macros.h"
+
 namespace nu {
 
+namespace {
+
+// Number of 32-bit arguments of each command, indexed by opcode.
+const size_t kCommandSizes[] = {
+  0,  // Save
+  0,  // Restore
+  0,  // BeginPath
+  0,  // ClosePath
+  2,  // MoveTo
+  2,  // LineTo
+  6,  // BezierCurveTo
+  5,  // Arc
+  4,  // Rect
+  0,  // Clip
+  4,  // ClipRect
+  2,  // Translate
+  1,  // Rotate
+  2,  // Scale
+  1,  // SetColor
+  1,  // SetStrokeColor
+  1,  // SetFillColor
+  1,  // SetLineWidth
+  0,  // Stroke
+  0,  // Fill
+  4,  // StrokeRect
+  4,  // FillRect
+};
+
+static_assert(arraysize(kCommandSizes) ==
+                  static_cast<size_t>(Painter::Command::FillRect) + 1,
+              "Every command should have its size");
+
+// Read 32-bit words from a command buffer. The buffer may come from scripts
+// without alignment guarantee, so words are copied out.
+class CommandReader {
+ public:
+  explicit CommandReader(const Buffer& buffer)
+      : data_(static_cast<const char*>(buffer.content())),
+        remaining_(buffer.size() / 4) {}
+
+  bool HasMore(size_t words) const { return remaining_ >= words; }
+
+  uint32_t ReadUint32() {
+    uint32_t value;
+    Read(&value);
+    return value;
+  }
+
+  float ReadFloat() {
+    float value;
+    Read(&value);
+    return value;
+  }
+
+  PointF ReadPoint() {
+    float x = ReadFloat();
+    float y = ReadFloat();
+    return PointF(x, y);
+  }
+
+  Vector2dF ReadVector() {
+    float x = ReadFloat();
+    float y = ReadFloat();
+    return Vector2dF(x, y);
+  }
+
+  RectF ReadRect() {
+    float x = ReadFloat();
+    float y = ReadFloat();
+    float width = ReadFloat();
+    float height = ReadFloat();
+    return RectF(x, y, width, height);
+  }
+
+ private:
+  template<typename T>
+  void Read(T* out) {
+    static_assert(sizeof(T) == 4, "Commands are made of 32-bit words");
+    memcpy(out, data_, 4);
+    data_ += 4;
+    remaining_--;
+  }
+
+  const char* data_;
+  size_t remaining_;
+
+  DISALLOW_COPY_AND_ASSIGN(CommandReader);
+};
+
+}  // namespace
+
 Painter::Painter() : weak_factory_(this) {}
 
 Painter::~Painter() {}
 
+bool Painter::Execute(const Buffer& buffer) {
+  if (buffer.size() % 4 != 0)
+    return false;
+  CommandReader reader(buffer);
+  while (reader.HasMore(1)) {
+    uint32_t opcode = reader.ReadUint32();
+    if (opcode >= arraysize(kCommandSizes) ||
+        !reader.HasMore(kCommandSizes[opcode]))
+      return false;
+    switch (static_cast<Command>(opcode)) {
+      case Command::Save:
+        Save();
+        break;
+      case Command::Restore:
+        Restore();
+        break;
+      case Command::BeginPath:
+        BeginPath();
+        break;
+      case Command::ClosePath:
+        ClosePath();
+        break;
+      case Command::MoveTo:
+        MoveTo(reader.ReadPoint());
+        break;
+      case Command::LineTo:
+        LineTo(reader.ReadPoint());
+        break;
+      case Command::BezierCurveTo: {
+        PointF cp1 = reader.ReadPoint();
+        PointF cp2 = reader.ReadPoint();
+        PointF ep = reader.ReadPoint();
+        BezierCurveTo(cp1, cp2, ep);
+        break;
+      }
+      case Command::Arc: {
+        PointF point = reader.ReadPoint();
+        float radius = reader.ReadFloat();
+        float sa = reader.ReadFloat();
+        float ea = reader.ReadFloat();
+        Arc(point, radius, sa, ea);
+        break;
+      }
+      case Command::Rect:
+        Rect(reader.ReadRect());
+        break;
+      case Command::Clip:
+        Clip();
+        break;
+      case Command::ClipRect:
+        ClipRect(reader.ReadRect());
+        break;
+      case Command::Translate:
+        Translate(reader.ReadVector());
+        break;
+      case Command::Rotate:
+        Rotate(reader.ReadFloat());
+        break;
+      case Command::Scale:
+        Scale(reader.ReadVector());
+        break;
+      case Command::SetColor:
+        SetColor(Color(reader.ReadUint32()));
+        break;
+      case Command::SetStrokeColor:
+        SetStrokeColor(Color(reader.ReadUint32()));
+        break;
+      case Command::SetFillColor:
+        SetFillColor(Color(reader.ReadUint32()));
+        break;
+      case Command::SetLineWidth:
+        SetLineWidth(reader.ReadFloat());
+        break;
+      case Command::Stroke:
+        Stroke();
+        break;
+      case Command::Fill:
+        Fill();
+        break;
+      case Command::StrokeRect:
+        StrokeRect(reader.ReadRect());
+        break;
+      case Command::FillRect:
+        FillRect(reader.ReadRect());
+        break;
+    }
+  }
+  return true;
+}
+
 }  // namespace nu
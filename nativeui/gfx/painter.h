@@ -5,10 +5,13 @@
 #ifndef NATIVEUI_GFX_PAINTER_H_
 #define NATIVEUI_GFX_PAINTER_H_
 
+#include <stdint.h>
+
 #include <memory>
 #include <string>
 
 #include "base/memory/weak_ptr.h"
+#include "nativeui/buffer.h"
 #include "nativeui/gfx/geometry/rect_f.h"
 #include "nativeui/gfx/text.h"
 #include "nativeui/types.h"
@@ -21,12 +24,47 @@ namespace nu {
 
 class Canvas;
 class Image;
+class Path;
 
 // The interface for painting on canvas or window.
 class NATIVEUI_EXPORT Painter {
  public:
+  // Opcodes of the commands in the buffer run by Execute.
+  enum class Command : uint32_t {
+    Save = 0,
+    Restore = 1,
+    BeginPath = 2,
+    ClosePath = 3,
+    MoveTo = 4,
+    LineTo = 5,
+    BezierCurveTo = 6,
+    Arc = 7,
+    Rect = 8,
+    Clip = 9,
+    ClipRect = 10,
+    Translate = 11,
+    Rotate = 12,
+    Scale = 13,
+    SetColor = 14,
+    SetStrokeColor = 15,
+    SetFillColor = 16,
+    SetLineWidth = 17,
+    Stroke = 18,
+    Fill = 19,
+    StrokeRect = 20,
+    FillRect = 21,
+  };
+
   virtual ~Painter();
 
+  // Run the commands in |buffer|, which is a sequence of 32-bit words in
+  // native byte order. Each command is an opcode followed by the arguments of
+  // the method with the same name: points, rects, vectors and numbers are
+  // floats, and colors are 32-bit ARGB integers.
+  // Returns false when meeting an invalid command, the commands before it
+  // have already been executed.
+  bool Execute(const Buffer& buffer);
+
   // Save/Restore current state.
   virtual void Save() = 0;
   virtual void Restore() = 0;
@@ -67,6 +105,12 @@ class NATIVEUI_EXPORT Painter {
   // Draw a solid shape by filling current path's content area.
   virtual void Fill() = 0;
 
+  // Stroke, fill or clip with a prebuilt |path| under current transform, the
+  // current path is cleared.
+  virtual void StrokePath(Path* path) = 0;
+  virtual void FillPath(Path* path) = 0;
+  virtual void ClipPath(Path* path) = 0;
+
   // Draw a single pixel |rect|.
   virtual void StrokeRect(const RectF& rect) = 0;
 
@@ -0,0 +1,101 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <string.h>
+
+#include <vector>
+
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class PainterTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    canvas_ = new nu::Canvas(nu::SizeF(10, 10), 1.f);
+  }
+
+  void AddCommand(nu::Painter::Command command) {
+    commands_.push_back(static_cast<uint32_t>(command));
+  }
+
+  void AddFloat(float value) {
+    uint32_t word;
+    memcpy(&word, &value, 4);
+    commands_.push_back(word);
+  }
+
+  bool Execute() {
+    return canvas_->GetPainter()->Execute(
+        nu::Buffer(commands_.data(), commands_.size() * 4));
+  }
+
+  uint32_t GetPixel(int x, int y) {
+    nu::Canvas::Pixels pixels;
+    EXPECT_TRUE(canvas_->LockPixels(&pixels));
+    uint32_t pixel = *reinterpret_cast<uint32_t*>(
+        static_cast<uint8_t*>(pixels.data) + y * pixels.stride + x * 4);
+    canvas_->UnlockPixels();
+    return pixel;
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::Canvas> canvas_;
+  std::vector<uint32_t> commands_;
+};
+
+TEST_F(PainterTest, Execute) {
+  AddCommand(nu::Painter::Command::SetFillColor);
+  commands_.push_back(0xFF00FF00);
+  AddCommand(nu::Painter::Command::FillRect);
+  AddFloat(0);
+  AddFloat(0);
+  AddFloat(5);
+  AddFloat(10);
+  EXPECT_TRUE(Execute());
+  EXPECT_EQ(GetPixel(2, 2), 0xFF00FF00);
+  EXPECT_EQ(GetPixel(7, 2), 0u);
+}
+
+TEST_F(PainterTest, ExecuteInvalidCommands) {
+  EXPECT_TRUE(Execute());
+  // Missing arguments.
+  AddCommand(nu::Painter::Command::MoveTo);
+  AddFloat(1);
+  EXPECT_FALSE(Execute());
+  // Unknown opcode.
+  commands_ = { 0xFFFF };
+  EXPECT_FALSE(Execute());
+  // Partial word.
+  commands_.clear();
+  AddCommand(nu::Painter::Command::Save);
+  EXPECT_FALSE(canvas_->GetPainter()->Execute(nu::Buffer(commands_.data(), 3)));
+}
+
+TEST_F(PainterTest, FillPath) {
+  scoped_refptr<nu::Path> path = new nu::Path;
+  // Transforms only apply to the points added later.
+  path->Rect(nu::RectF(0, 0, 2, 2));
+  path->Translate(nu::Vector2dF(5, 0));
+  path->Rect(nu::RectF(0, 0, 5, 10));
+  nu::Painter* painter = canvas_->GetPainter();
+  painter->SetFillColor(nu::Color(0xFF00FF00));
+  painter->FillPath(path.get());
+  EXPECT_EQ(GetPixel(0, 0), 0xFF00FF00);
+  EXPECT_EQ(GetPixel(3, 5), 0u);
+  EXPECT_EQ(GetPixel(7, 5), 0xFF00FF00);
+  // The same path can be drawn again.
+  painter->Translate(nu::Vector2dF(-5, 0));
+  painter->FillPath(path.get());
+  EXPECT_EQ(GetPixel(3, 5), 0xFF00FF00);
+}
+
+TEST_F(PainterTest, ArcPath) {
+  scoped_refptr<nu::Path> path = new nu::Path;
+  path->Arc(nu::PointF(5, 5), 4, 0, 2 * 3.14159265f);
+  canvas_->GetPainter()->SetFillColor(nu::Color(0xFF00FF00));
+  canvas_->GetPainter()->FillPath(path.get());
+  EXPECT_EQ(GetPixel(5, 5), 0xFF00FF00);
+  EXPECT_EQ(GetPixel(0, 0), 0u);
+}
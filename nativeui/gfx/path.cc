@@ -0,0 +1,125 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/path.h"
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace nu {
+
+Path::Path() {
+  PlatformInit();
+}
+
+Path::~Path() {
+  PlatformDestroy();
+}
+
+void Path::MoveTo(const PointF& point) {
+  current_point_ = subpath_start_ = Map(point);
+  has_current_point_ = true;
+  PlatformMoveTo(current_point_);
+}
+
+void Path::LineTo(const PointF& point) {
+  if (!has_current_point_) {
+    MoveTo(point);
+    return;
+  }
+  PointF p = Map(point);
+  PlatformLineTo(p);
+  current_point_ = p;
+}
+
+void Path::BezierCurveTo(const PointF& cp1,
+                         const PointF& cp2,
+                         const PointF& ep) {
+  if (!has_current_point_)
+    MoveTo(cp1);
+  PointF p = Map(ep);
+  PlatformBezierCurveTo(Map(cp1), Map(cp2), p);
+  current_point_ = p;
+}
+
+void Path::Arc(const PointF& point, float radius, float sa, float ea) {
+  if (!std::isfinite(sa) || !std::isfinite(ea))
+    return;
+  // Same with Painter, the arc goes clockwise and |ea| is increased by 2 pi
+  // until it is not less than |sa|.
+  const float kFullCircle = 2.f * static_cast<float>(M_PI);
+  if (ea < sa)
+    ea += ceilf((sa - ea) / kFullCircle) * kFullCircle;
+
+  // Connect previous point to the start of arc.
+  auto at = [&](float angle, float distance) {
+    return PointF(point.x() + distance * cosf(angle),
+                  point.y() + distance * sinf(angle));
+  };
+  LineTo(at(sa, radius));
+
+  // Transforms may be non-uniform, so the arc is approximated with cubic
+  // Bézier curves of no more than 90 degrees, which keep their shape under
+  // affine transforms.
+  const float kMaxSegment = static_cast<float>(M_PI) / 2.f;
+  int segments = static_cast<int>(ceilf((ea - sa) / kMaxSegment));
+  float step = (ea - sa) / std::max(segments, 1);
+  float k = 4.f / 3.f * tanf(step / 4.f) * radius;
+  for (int i = 0; i < segments; ++i) {
+    float a0 = sa + i * step;
+    float a1 = i == segments - 1 ? ea : a0 + step;
+    PointF p0 = at(a0, radius);
+    PointF p1 = at(a1, radius);
+    BezierCurveTo(PointF(p0.x() - k * sinf(a0), p0.y() + k * cosf(a0)),
+                  PointF(p1.x() + k * sinf(a1), p1.y() - k * cosf(a1)),
+                  p1);
+  }
+}
+
+void Path::Rect(const RectF& rect) {
+  MoveTo(rect.origin());
+  LineTo(rect.top_right());
+  LineTo(rect.bottom_right());
+  LineTo(rect.bottom_left());
+  ClosePath();
+}
+
+void Path::ClosePath() {
+  if (!has_current_point_)
+    return;
+  PlatformClosePath();
+  current_point_ = subpath_start_;
+}
+
+void Path::Translate(const Vector2dF& offset) {
+  matrix_[4] += matrix_[0] * offset.x() + matrix_[2] * offset.y();
+  matrix_[5] += matrix_[1] * offset.x() + matrix_[3] * offset.y();
+}
+
+void Path::Rotate(float angle) {
+  float c = cosf(angle), s = sinf(angle);
+  float m0 = matrix_[0], m1 = matrix_[1];
+  matrix_[0] = m0 * c + matrix_[2] * s;
+  matrix_[1] = m1 * c + matrix_[3] * s;
+  matrix_[2] = matrix_[2] * c - m0 * s;
+  matrix_[3] = matrix_[3] * c - m1 * s;
+}
+
+void Path::Scale(const Vector2dF& scale) {
+  matrix_[0] *= scale.x();
+  matrix_[1] *= scale.x();
+  matrix_[2] *= scale.y();
+  matrix_[3] *= scale.y();
+}
+
+PointF Path::Map(const PointF& point) const {
+  return PointF(
+      matrix_[0] * point.x() + matrix_[2] * point.y() + matrix_[4],
+      matrix_[1] * point.x() + matrix_[3] * point.y() + matrix_[5]);
+}
+
+}  // namespace nu
@@ -0,0 +1,77 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_GFX_PATH_H_
+#define NATIVEUI_GFX_PATH_H_
+
+#include "base/memory/ref_counted.h"
+#include "nativeui/gfx/geometry/rect_f.h"
+#include "nativeui/gfx/geometry/vector2d_f.h"
+#include "nativeui/nativeui_export.h"
+#include "nativeui/types.h"
+
+namespace nu {
+
+// A path stored in native format, which can be built once and drawn many
+// times with Painter::FillPath, StrokePath and ClipPath.
+class NATIVEUI_EXPORT Path : public base::RefCounted<Path> {
+ public:
+  Path();
+
+  // Path operations, which work like the ones of Painter.
+  void MoveTo(const PointF& point);
+  void LineTo(const PointF& point);
+  void BezierCurveTo(const PointF& cp1, const PointF& cp2, const PointF& ep);
+  void Arc(const PointF& point, float radius, float sa, float ea);
+  void Rect(const RectF& rect);
+  void ClosePath();
+
+  // Transform the points added later, existing points are not affected.
+  void Translate(const Vector2dF& offset);
+  void Rotate(float angle);
+  void Scale(const Vector2dF& scale);
+
+  NativePath GetNative() const { return path_; }
+
+ protected:
+  virtual ~Path();
+
+ private:
+  friend class base::RefCounted<Path>;
+
+  // The points passed to platform functions have been transformed.
+  void PlatformInit();
+  void PlatformDestroy();
+  void PlatformMoveTo(const PointF& point);
+  void PlatformLineTo(const PointF& point);
+  void PlatformBezierCurveTo(const PointF& cp1,
+                             const PointF& cp2,
+                             const PointF& ep);
+  void PlatformClosePath();
+
+  // Apply the transform to |point|.
+  PointF Map(const PointF& point) const;
+
+  NativePath path_;
+
+  // The affine transform mapping (x, y) to
+  // (m[0] * x + m[2] * y + m[4], m[1] * x + m[3] * y + m[5]).
+  float matrix_[6] = { 1.f, 0.f, 0.f, 1.f, 0.f, 0.f };
+
+  // Transformed positions of current point and start of current sub-path.
+  bool has_current_point_ = false;
+  PointF current_point_;
+  PointF subpath_start_;
+
+#if defined(OS_LINUX)
+  // Number of cairo_path_data_t allocated for path data.
+  int capacity_ = 0;
+#endif
+
+  DISALLOW_COPY_AND_ASSIGN(Path);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_GFX_PATH_H_
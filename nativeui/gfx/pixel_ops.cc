@@ -0,0 +1,297 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/pixel_ops.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+
+#include "base/lazy_instance.h"
+#include "nativeui/gfx/painter.h"
+#include "nativeui/gfx/pixel_ops_internal.h"
+
+#if defined(ARCH_CPU_X86_FAMILY)
+#include "base/cpu.h"
+#endif
+
+namespace nu {
+
+namespace internal {
+
+namespace {
+
+// Exact x / 255 for x in [0, 255 * 255], rounded to nearest.
+inline uint32_t Div255(uint32_t x) {
+  x += 128;
+  return (x + (x >> 8)) >> 8;
+}
+
+inline uint32_t ClampToByte(float value) {
+  return static_cast<uint32_t>(std::min(std::max(value, 0.f), 255.f) + 0.5f);
+}
+
+}  // namespace
+
+void PremultiplyScalar(uint32_t* pixels, int count) {
+  for (int i = 0; i < count; ++i) {
+    uint32_t p = pixels[i];
+    uint32_t a = p >> 24;
+    uint32_t r = Div255(((p >> 16) & 0xFF) * a);
+    uint32_t g = Div255(((p >> 8) & 0xFF) * a);
+    uint32_t b = Div255((p & 0xFF) * a);
+    pixels[i] = (a << 24) | (r << 16) | (g << 8) | b;
+  }
+}
+
+void UnpremultiplyScalar(uint32_t* pixels, int count) {
+  for (int i = 0; i < count; ++i) {
+    uint32_t p = pixels[i];
+    uint32_t a = p >> 24;
+    if (a == 255)
+      continue;
+    if (a == 0) {
+      pixels[i] = 0;
+      continue;
+    }
+    uint32_t r = std::min((((p >> 16) & 0xFF) * 255 + a / 2) / a, 255u);
+    uint32_t g = std::min((((p >> 8) & 0xFF) * 255 + a / 2) / a, 255u);
+    uint32_t b = std::min(((p & 0xFF) * 255 + a / 2) / a, 255u);
+    pixels[i] = (a << 24) | (r << 16) | (g << 8) | b;
+  }
+}
+
+void ColorMatrixScalar(uint32_t* pixels, int count, const float* m) {
+  for (int i = 0; i < count; ++i) {
+    uint32_t p = pixels[i];
+    float c[4] = { static_cast<float>((p >> 16) & 0xFF),
+                   static_cast<float>((p >> 8) & 0xFF),
+                   static_cast<float>(p & 0xFF),
+                   static_cast<float>(p >> 24) };
+    uint32_t out[4];
+    for (int k = 0; k < 4; ++k) {
+      const float* row = m + k * 5;
+      out[k] = ClampToByte(row[0] * c[0] + row[1] * c[1] + row[2] * c[2] +
+                           row[3] * c[3] + row[4] * 255.f);
+    }
+    pixels[i] = (out[3] << 24) | (out[0] << 16) | (out[1] << 8) | out[2];
+  }
+}
+
+void BlendScalar(uint32_t* dest, const uint32_t* src, int count) {
+  for (int i = 0; i < count; ++i) {
+    uint32_t s = src[i];
+    uint32_t d = dest[i];
+    uint32_t inv = 255 - (s >> 24);
+    uint32_t result = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+      uint32_t c = Div255(((d >> shift) & 0xFF) * inv);
+      c += (s >> shift) & 0xFF;
+      result |= std::min(c, 255u) << shift;
+    }
+    dest[i] = result;
+  }
+}
+
+void BoxBlurScalar(const uint32_t* src, uint32_t* dest, int count, int step,
+                   int radius) {
+  // Pixels outside the edges take the value of the edge pixels.
+  auto at = [=](int i) {
+    return src[static_cast<ptrdiff_t>(std::min(std::max(i, 0), count - 1)) *
+               step];
+  };
+  int sum[4] = { 0 };
+  auto add = [&sum](uint32_t p, int sign) {
+    for (int k = 0; k < 4; ++k)
+      sum[k] += sign * static_cast<int>((p >> (k * 8)) & 0xFF);
+  };
+  for (int i = -radius; i <= radius; ++i)
+    add(at(i), 1);
+  float scale = 1.f / (2 * radius + 1);
+  for (int i = 0; i < count; ++i) {
+    uint32_t result = 0;
+    for (int k = 0; k < 4; ++k)
+      result |= ClampToByte(sum[k] * scale) << (k * 8);
+    dest[static_cast<ptrdiff_t>(i) * step] = result;
+    add(at(i + radius + 1), 1);
+    add(at(i - radius), -1);
+  }
+}
+
+void FillScalarKernels(PixelKernels* kernels) {
+  kernels->premultiply = &PremultiplyScalar;
+  kernels->unpremultiply = &UnpremultiplyScalar;
+  kernels->color_matrix = &ColorMatrixScalar;
+  kernels->blend = &BlendScalar;
+  kernels->box_blur = &BoxBlurScalar;
+}
+
+}  // namespace internal
+
+namespace {
+
+using internal::PixelKernels;
+
+struct KernelsData {
+  KernelsData() {
+#if defined(ARCH_CPU_X86_FAMILY)
+    base::CPU cpu;
+    if (cpu.has_avx2())
+      best = PixelOps::InstructionSet::AVX2;
+    else if (cpu.has_sse2())
+      best = PixelOps::InstructionSet::SSE2;
+#endif
+    Select(best);
+  }
+
+  void Select(PixelOps::InstructionSet set) {
+    current = std::min(set, best);
+    internal::FillScalarKernels(&kernels);
+#if defined(ARCH_CPU_X86_FAMILY)
+    if (current >= PixelOps::InstructionSet::SSE2)
+      internal::FillSSE2Kernels(&kernels);
+    if (current >= PixelOps::InstructionSet::AVX2)
+      internal::FillAVX2Kernels(&kernels);
+#endif
+  }
+
+  PixelOps::InstructionSet best = PixelOps::InstructionSet::Scalar;
+  PixelOps::InstructionSet current = PixelOps::InstructionSet::Scalar;
+  PixelKernels kernels;
+};
+
+base::LazyInstance<KernelsData>::Leaky g_kernels = LAZY_INSTANCE_INITIALIZER;
+
+inline const PixelKernels& GetKernels() {
+  return g_kernels.Get().kernels;
+}
+
+inline uint32_t* GetRow(const Canvas::Pixels& pixels, int y) {
+  return reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(pixels.data) +
+                                     static_cast<ptrdiff_t>(y) *
+                                     pixels.stride);
+}
+
+inline bool IsPremultiplied(const Canvas::Pixels& pixels) {
+  return pixels.format == Canvas::Pixels::Format::PremultipliedARGB;
+}
+
+}  // namespace
+
+// static
+PixelOps::InstructionSet PixelOps::GetInstructionSet() {
+  return g_kernels.Get().current;
+}
+
+// static
+void PixelOps::SetInstructionSet(InstructionSet set) {
+  g_kernels.Get().Select(set);
+}
+
+// static
+scoped_refptr<Canvas> PixelOps::CreateCanvasFromImage(Image* image) {
+  scoped_refptr<Canvas> canvas(
+      new Canvas(image->GetSize(), image->GetScaleFactor()));
+  canvas->GetPainter()->DrawImage(image, RectF(image->GetSize()));
+  return canvas;
+}
+
+// static
+void PixelOps::Premultiply(uint32_t* pixels, size_t count) {
+  GetKernels().premultiply(pixels, static_cast<int>(count));
+}
+
+// static
+void PixelOps::Unpremultiply(uint32_t* pixels, size_t count) {
+  GetKernels().unpremultiply(pixels, static_cast<int>(count));
+}
+
+// static
+bool PixelOps::BoxBlur(Canvas* canvas, int radius) {
+  Canvas::Pixels pixels;
+  if (radius < 0 || !canvas->LockPixels(&pixels))
+    return false;
+  const PixelKernels& kernels = GetKernels();
+  // Blurring must be done in premultiplied alpha.
+  if (!IsPremultiplied(pixels)) {
+    for (int y = 0; y < pixels.height; ++y)
+      kernels.premultiply(GetRow(pixels, y), pixels.width);
+  }
+  // Blur rows into a buffer of the same layout, and then columns back.
+  int step = pixels.stride / 4;
+  std::vector<uint32_t> buffer(static_cast<size_t>(step) * pixels.height);
+  for (int y = 0; y < pixels.height; ++y) {
+    kernels.box_blur(GetRow(pixels, y),
+                     &buffer[static_cast<size_t>(y) * step],
+                     pixels.width, 1, radius);
+  }
+  for (int x = 0; x < pixels.width; ++x)
+    kernels.box_blur(&buffer[x], GetRow(pixels, 0) + x, pixels.height, step,
+                     radius);
+  if (!IsPremultiplied(pixels)) {
+    for (int y = 0; y < pixels.height; ++y)
+      kernels.unpremultiply(GetRow(pixels, y), pixels.width);
+  }
+  canvas->UnlockPixels();
+  return true;
+}
+
+// static
+bool PixelOps::ApplyColorMatrix(Canvas* canvas,
+                                const std::vector<float>& matrix) {
+  Canvas::Pixels pixels;
+  if (matrix.size() != 20 || !canvas->LockPixels(&pixels))
+    return false;
+  const PixelKernels& kernels = GetKernels();
+  for (int y = 0; y < pixels.height; ++y) {
+    uint32_t* row = GetRow(pixels, y);
+    if (IsPremultiplied(pixels))
+      kernels.unpremultiply(row, pixels.width);
+    kernels.color_matrix(row, pixels.width, matrix.data());
+    if (IsPremultiplied(pixels))
+      kernels.premultiply(row, pixels.width);
+  }
+  canvas->UnlockPixels();
+  return true;
+}
+
+// static
+bool PixelOps::Blend(Canvas* dest, Canvas* src) {
+  Canvas::Pixels dest_pixels;
+  if (!dest->LockPixels(&dest_pixels))
+    return false;
+  Canvas::Pixels src_pixels;
+  if (!src->LockPixels(&src_pixels)) {
+    dest->UnlockPixels();
+    return false;
+  }
+  bool success = dest_pixels.width == src_pixels.width &&
+                 dest_pixels.height == src_pixels.height;
+  if (success) {
+    const PixelKernels& kernels = GetKernels();
+    // Rows of source are converted in a buffer when not premultiplied.
+    std::vector<uint32_t> buffer;
+    if (!IsPremultiplied(src_pixels))
+      buffer.resize(src_pixels.width);
+    for (int y = 0; y < dest_pixels.height; ++y) {
+      uint32_t* dest_row = GetRow(dest_pixels, y);
+      const uint32_t* src_row = GetRow(src_pixels, y);
+      if (!IsPremultiplied(src_pixels)) {
+        std::copy(src_row, src_row + src_pixels.width, buffer.begin());
+        kernels.premultiply(buffer.data(), src_pixels.width);
+        src_row = buffer.data();
+      }
+      if (!IsPremultiplied(dest_pixels))
+        kernels.premultiply(dest_row, dest_pixels.width);
+      kernels.blend(dest_row, src_row, dest_pixels.width);
+      if (!IsPremultiplied(dest_pixels))
+        kernels.unpremultiply(dest_row, dest_pixels.width);
+    }
+  }
+  src->UnlockPixels();
+  dest->UnlockPixels();
+  return success;
+}
+
+}  // namespace nu
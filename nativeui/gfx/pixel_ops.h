@@ -0,0 +1,67 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_GFX_PIXEL_OPS_H_
+#define NATIVEUI_GFX_PIXEL_OPS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "nativeui/gfx/canvas.h"
+#include "nativeui/gfx/image.h"
+
+namespace nu {
+
+// Image processing on pixels of canvas. Each operation has SIMD versions, the
+// best one supported by the CPU is selected at runtime.
+//
+// Images are immutable and may be shared by the image cache, to process an
+// image copy it to a canvas with CreateCanvasFromImage first.
+class NATIVEUI_EXPORT PixelOps {
+ public:
+  enum class InstructionSet {
+    Scalar,
+    SSE2,
+    AVX2,
+  };
+
+  // Return the instruction set being used.
+  static InstructionSet GetInstructionSet();
+
+  // Use |set| for later operations, it is capped to the best one supported by
+  // the CPU. This is mainly used for benchmarking and testing.
+  static void SetInstructionSet(InstructionSet set);
+
+  // Create a canvas with the same size and scale factor of |image|, and draw
+  // the image on it.
+  static scoped_refptr<Canvas> CreateCanvasFromImage(Image* image);
+
+  // Convert 32-bit ARGB pixels to premultiplied alpha in place, and the
+  // reverse.
+  static void Premultiply(uint32_t* pixels, size_t count);
+  static void Unpremultiply(uint32_t* pixels, size_t count);
+
+  // Blur the canvas with a box filter of |radius| pixels, applying it 3 times
+  // approximates a gaussian blur.
+  static bool BoxBlur(Canvas* canvas, int radius);
+
+  // Transform colors of canvas with a 4x5 row-major matrix, which maps the
+  // unpremultiplied (R, G, B, A, 1) to (R', G', B', A') with channels in the
+  // range of [0, 1], like the feColorMatrix filter of SVG.
+  static bool ApplyColorMatrix(Canvas* canvas,
+                               const std::vector<float>& matrix);
+
+  // Composite |src| over |dest| with the source-over operator, both canvases
+  // must have the same pixel size.
+  static bool Blend(Canvas* dest, Canvas* src);
+
+ private:
+  DISALLOW_IMPLICIT_CONSTRUCTORS(PixelOps);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_GFX_PIXEL_OPS_H_
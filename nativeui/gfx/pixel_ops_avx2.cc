@@ -0,0 +1,130 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+// This file is compiled with AVX2 enabled, and its kernels are only used when
+// the CPU supports AVX2.
+
+#include <immintrin.h>
+
+#include "nativeui/gfx/pixel_ops_internal.h"
+
+namespace nu {
+
+namespace internal {
+
+namespace {
+
+// Mask of the alpha channels of 4 pixels unpacked to 16-bit lanes.
+inline __m256i AlphaMask() {
+  return _mm256_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0,
+                          -1, 0, 0, 0, -1, 0, 0, 0);
+}
+
+// Exact x / 255 in 16-bit lanes, see Div255 in pixel_ops.cc.
+inline __m256i Div255(__m256i x) {
+  x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+  return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+}
+
+// Broadcast the alpha of 4 pixels unpacked to 16-bit lanes.
+inline __m256i SplatAlpha(__m256i x) {
+  x = _mm256_shufflelo_epi16(x, _MM_SHUFFLE(3, 3, 3, 3));
+  return _mm256_shufflehi_epi16(x, _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+inline __m256i Premultiply4(__m256i x) {
+  __m256i factor = _mm256_or_si256(
+      _mm256_andnot_si256(AlphaMask(), SplatAlpha(x)),
+      _mm256_and_si256(AlphaMask(), _mm256_set1_epi16(255)));
+  return Div255(_mm256_mullo_epi16(x, factor));
+}
+
+inline __m256i MultiplyInverseAlpha(__m256i x, __m256i src) {
+  __m256i inverse = _mm256_sub_epi16(_mm256_set1_epi16(255), SplatAlpha(src));
+  return Div255(_mm256_mullo_epi16(x, inverse));
+}
+
+// Put |x| in both 128-bit lanes.
+inline __m256 Broadcast(__m128 x) {
+  return _mm256_insertf128_ps(_mm256_castps128_ps256(x), x, 1);
+}
+
+// The unpacking and packing instructions work inside 128-bit lanes, so the
+// pixels keep their order after unpacking and packing them back.
+void PremultiplyAVX2(uint32_t* pixels, int count) {
+  const __m256i zero = _mm256_setzero_si256();
+  int i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i* p = reinterpret_cast<__m256i*>(pixels + i);
+    __m256i x = _mm256_loadu_si256(p);
+    __m256i lo = Premultiply4(_mm256_unpacklo_epi8(x, zero));
+    __m256i hi = Premultiply4(_mm256_unpackhi_epi8(x, zero));
+    _mm256_storeu_si256(p, _mm256_packus_epi16(lo, hi));
+  }
+  PremultiplyScalar(pixels + i, count - i);
+}
+
+// Two pixels are processed at once, each in a 128-bit lane.
+void ColorMatrixAVX2(uint32_t* pixels, int count, const float* m) {
+  __m256 columns[4];
+  for (int j = 0; j < 4; ++j)
+    columns[j] = Broadcast(_mm_set_ps(m[15 + j], m[j], m[5 + j], m[10 + j]));
+  __m256 offset = _mm256_mul_ps(
+      Broadcast(_mm_set_ps(m[19], m[4], m[9], m[14])),
+      _mm256_set1_ps(255.f));
+  int i = 0;
+  for (; i + 2 <= count; i += 2) {
+    __m128i two = _mm_loadl_epi64(reinterpret_cast<__m128i*>(pixels + i));
+    __m256 c = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(two));
+    __m256 r = _mm256_shuffle_ps(c, c, _MM_SHUFFLE(2, 2, 2, 2));
+    __m256 g = _mm256_shuffle_ps(c, c, _MM_SHUFFLE(1, 1, 1, 1));
+    __m256 b = _mm256_shuffle_ps(c, c, _MM_SHUFFLE(0, 0, 0, 0));
+    __m256 a = _mm256_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 3, 3));
+    __m256 x = _mm256_add_ps(_mm256_mul_ps(columns[0], r),
+                             _mm256_mul_ps(columns[1], g));
+    x = _mm256_add_ps(x, _mm256_mul_ps(columns[2], b));
+    x = _mm256_add_ps(x, _mm256_mul_ps(columns[3], a));
+    x = _mm256_add_ps(x, offset);
+    x = _mm256_min_ps(_mm256_max_ps(x, _mm256_setzero_ps()),
+                      _mm256_set1_ps(255.f));
+    __m256i y = _mm256_cvttps_epi32(_mm256_add_ps(x, _mm256_set1_ps(0.5f)));
+    y = _mm256_packs_epi32(y, y);
+    y = _mm256_packus_epi16(y, y);
+    pixels[i] = static_cast<uint32_t>(
+        _mm_cvtsi128_si32(_mm256_castsi256_si128(y)));
+    pixels[i + 1] = static_cast<uint32_t>(
+        _mm_cvtsi128_si32(_mm256_extracti128_si256(y, 1)));
+  }
+  ColorMatrixScalar(pixels + i, count - i, m);
+}
+
+void BlendAVX2(uint32_t* dest, const uint32_t* src, int count) {
+  const __m256i zero = _mm256_setzero_si256();
+  int i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i* d = reinterpret_cast<__m256i*>(dest + i);
+    __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    __m256i x = _mm256_loadu_si256(d);
+    __m256i lo = MultiplyInverseAlpha(_mm256_unpacklo_epi8(x, zero),
+                                      _mm256_unpacklo_epi8(s, zero));
+    __m256i hi = MultiplyInverseAlpha(_mm256_unpackhi_epi8(x, zero),
+                                      _mm256_unpackhi_epi8(s, zero));
+    _mm256_storeu_si256(d, _mm256_adds_epu8(s, _mm256_packus_epi16(lo, hi)));
+  }
+  BlendScalar(dest + i, src + i, count - i);
+}
+
+}  // namespace
+
+// The box blur is bound by its serial running sum, so the SSE2 version is
+// kept.
+void FillAVX2Kernels(PixelKernels* kernels) {
+  kernels->premultiply = &PremultiplyAVX2;
+  kernels->color_matrix = &ColorMatrixAVX2;
+  kernels->blend = &BlendAVX2;
+}
+
+}  // namespace internal
+
+}  // namespace nu
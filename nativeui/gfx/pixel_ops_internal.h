@@ -0,0 +1,50 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_GFX_PIXEL_OPS_INTERNAL_H_
+#define NATIVEUI_GFX_PIXEL_OPS_INTERNAL_H_
+
+#include <stdint.h>
+
+#include "build/build_config.h"
+
+namespace nu {
+
+namespace internal {
+
+// The kernels working on runs of 32-bit ARGB pixels.
+struct PixelKernels {
+  void (*premultiply)(uint32_t* pixels, int count);
+  void (*unpremultiply)(uint32_t* pixels, int count);
+  // The |matrix| has 20 floats and pixels are unpremultiplied.
+  void (*color_matrix)(uint32_t* pixels, int count, const float* matrix);
+  // Source-over compositing of premultiplied pixels.
+  void (*blend)(uint32_t* dest, const uint32_t* src, int count);
+  // Box blur |count| premultiplied pixels that are |step| pixels apart, the
+  // |src| and |dest| must not overlap.
+  void (*box_blur)(const uint32_t* src, uint32_t* dest, int count, int step,
+                   int radius);
+};
+
+// The scalar kernels, which are also used by SIMD kernels for the remaining
+// pixels that do not fill a vector.
+void PremultiplyScalar(uint32_t* pixels, int count);
+void UnpremultiplyScalar(uint32_t* pixels, int count);
+void ColorMatrixScalar(uint32_t* pixels, int count, const float* matrix);
+void BlendScalar(uint32_t* dest, const uint32_t* src, int count);
+void BoxBlurScalar(const uint32_t* src, uint32_t* dest, int count, int step,
+                   int radius);
+
+// Each function overrides the kernels it has optimized versions of.
+void FillScalarKernels(PixelKernels* kernels);
+#if defined(ARCH_CPU_X86_FAMILY)
+void FillSSE2Kernels(PixelKernels* kernels);
+void FillAVX2Kernels(PixelKernels* kernels);
+#endif
+
+}  // namespace internal
+
+}  // namespace nu
+
+#endif  // NATIVEUI_GFX_PIXEL_OPS_INTERNAL_H_
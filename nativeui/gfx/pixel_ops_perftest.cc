@@ -0,0 +1,94 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "base/logging.h"
+#include "base/timer/elapsed_timer.h"
+#include "nativeui/gfx/pixel_ops.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+const int kIterations = 10;
+
+const char* GetName(nu::PixelOps::InstructionSet set) {
+  switch (set) {
+    case nu::PixelOps::InstructionSet::Scalar: return "Scalar";
+    case nu::PixelOps::InstructionSet::SSE2: return "SSE2";
+    case nu::PixelOps::InstructionSet::AVX2: return "AVX2";
+  }
+  return "";
+}
+
+}  // namespace
+
+class PixelOpsPerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    best_ = nu::PixelOps::GetInstructionSet();
+    canvas_ = new nu::Canvas(nu::SizeF(1920, 1080), 1.f);
+    src_ = new nu::Canvas(nu::SizeF(1920, 1080), 1.f);
+  }
+
+  void TearDown() override {
+    nu::PixelOps::SetInstructionSet(best_);
+  }
+
+  // Run |op| with scalar kernels and then the best kernels.
+  template<typename Op>
+  void Compare(const std::string& label, const Op& op) {
+    for (auto set : { nu::PixelOps::InstructionSet::Scalar, best_ }) {
+      nu::PixelOps::SetInstructionSet(set);
+      base::ElapsedTimer timer;
+      for (int i = 0; i < kIterations; ++i)
+        ASSERT_TRUE(op());
+      LOG(INFO) << label << " " << GetName(set) << ": "
+                << timer.Elapsed().InMilliseconds() << "ms";
+    }
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  nu::PixelOps::InstructionSet best_;
+  scoped_refptr<nu::Canvas> canvas_;
+  scoped_refptr<nu::Canvas> src_;
+};
+
+TEST_F(PixelOpsPerfTest, Premultiply) {
+  nu::Canvas::Pixels pixels;
+  ASSERT_TRUE(canvas_->LockPixels(&pixels));
+  size_t count = pixels.stride / 4 * pixels.height;
+  Compare("Premultiply 1080p", [&]() {
+    nu::PixelOps::Premultiply(static_cast<uint32_t*>(pixels.data), count);
+    return true;
+  });
+  canvas_->UnlockPixels();
+}
+
+TEST_F(PixelOpsPerfTest, BoxBlur) {
+  Compare("BoxBlur 1080p", [this]() {
+    return nu::PixelOps::BoxBlur(canvas_.get(), 8);
+  });
+}
+
+TEST_F(PixelOpsPerfTest, ApplyColorMatrix) {
+  std::vector<float> matrix = {
+    0.3f, 0.59f, 0.11f, 0, 0,
+    0.3f, 0.59f, 0.11f, 0, 0,
+    0.3f, 0.59f, 0.11f, 0, 0,
+    0, 0, 0, 1, 0,
+  };
+  Compare("ApplyColorMatrix 1080p", [&]() {
+    return nu::PixelOps::ApplyColorMatrix(canvas_.get(), matrix);
+  });
+}
+
+TEST_F(PixelOpsPerfTest, Blend) {
+  Compare("Blend 1080p", [this]() {
+    return nu::PixelOps::Blend(canvas_.get(), src_.get());
+  });
+}
@@ -0,0 +1,145 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <emmintrin.h>
+#include <stddef.h>
+
+#include <algorithm>
+
+#include "nativeui/gfx/pixel_ops_internal.h"
+
+namespace nu {
+
+namespace internal {
+
+namespace {
+
+// Mask of the alpha channels of 2 pixels unpacked to 16-bit lanes.
+inline __m128i AlphaMask() {
+  return _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+}
+
+// Exact x / 255 in 16-bit lanes, see Div255 in pixel_ops.cc.
+inline __m128i Div255(__m128i x) {
+  x = _mm_add_epi16(x, _mm_set1_epi16(128));
+  return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+// Broadcast the alpha of 2 pixels unpacked to 16-bit lanes.
+inline __m128i SplatAlpha(__m128i x) {
+  x = _mm_shufflelo_epi16(x, _MM_SHUFFLE(3, 3, 3, 3));
+  return _mm_shufflehi_epi16(x, _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+// Premultiply 2 pixels unpacked to 16-bit lanes.
+inline __m128i Premultiply2(__m128i x) {
+  // The alpha channel is multiplied by 255 so it keeps unchanged.
+  __m128i factor = _mm_or_si128(
+      _mm_andnot_si128(AlphaMask(), SplatAlpha(x)),
+      _mm_and_si128(AlphaMask(), _mm_set1_epi16(255)));
+  return Div255(_mm_mullo_epi16(x, factor));
+}
+
+// Multiply 2 pixels unpacked to 16-bit lanes by the inverse alpha of |src|.
+inline __m128i MultiplyInverseAlpha(__m128i x, __m128i src) {
+  __m128i inverse = _mm_sub_epi16(_mm_set1_epi16(255), SplatAlpha(src));
+  return Div255(_mm_mullo_epi16(x, inverse));
+}
+
+// Clamp floats to [0, 255] and round them, then pack to bytes.
+inline uint32_t PackPixel(__m128 x) {
+  x = _mm_min_ps(_mm_max_ps(x, _mm_setzero_ps()), _mm_set1_ps(255.f));
+  __m128i i = _mm_cvttps_epi32(_mm_add_ps(x, _mm_set1_ps(0.5f)));
+  i = _mm_packs_epi32(i, i);
+  return static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_packus_epi16(i, i)));
+}
+
+// Unpack a pixel to 32-bit lanes.
+inline __m128i UnpackPixel(uint32_t p) {
+  __m128i zero = _mm_setzero_si128();
+  __m128i x = _mm_cvtsi32_si128(static_cast<int>(p));
+  return _mm_unpacklo_epi16(_mm_unpacklo_epi8(x, zero), zero);
+}
+
+void PremultiplySSE2(uint32_t* pixels, int count) {
+  const __m128i zero = _mm_setzero_si128();
+  int i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128i* p = reinterpret_cast<__m128i*>(pixels + i);
+    __m128i x = _mm_loadu_si128(p);
+    __m128i lo = Premultiply2(_mm_unpacklo_epi8(x, zero));
+    __m128i hi = Premultiply2(_mm_unpackhi_epi8(x, zero));
+    _mm_storeu_si128(p, _mm_packus_epi16(lo, hi));
+  }
+  PremultiplyScalar(pixels + i, count - i);
+}
+
+void ColorMatrixSSE2(uint32_t* pixels, int count, const float* m) {
+  // Columns of the matrix in the BGRA order of pixels in memory.
+  __m128 columns[4];
+  for (int j = 0; j < 4; ++j)
+    columns[j] = _mm_set_ps(m[15 + j], m[j], m[5 + j], m[10 + j]);
+  __m128 offset = _mm_mul_ps(_mm_set_ps(m[19], m[4], m[9], m[14]),
+                             _mm_set1_ps(255.f));
+  for (int i = 0; i < count; ++i) {
+    __m128 c = _mm_cvtepi32_ps(UnpackPixel(pixels[i]));
+    __m128 r = _mm_shuffle_ps(c, c, _MM_SHUFFLE(2, 2, 2, 2));
+    __m128 g = _mm_shuffle_ps(c, c, _MM_SHUFFLE(1, 1, 1, 1));
+    __m128 b = _mm_shuffle_ps(c, c, _MM_SHUFFLE(0, 0, 0, 0));
+    __m128 a = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 3, 3));
+    __m128 x = _mm_add_ps(_mm_mul_ps(columns[0], r),
+                          _mm_mul_ps(columns[1], g));
+    x = _mm_add_ps(x, _mm_mul_ps(columns[2], b));
+    x = _mm_add_ps(x, _mm_mul_ps(columns[3], a));
+    pixels[i] = PackPixel(_mm_add_ps(x, offset));
+  }
+}
+
+void BlendSSE2(uint32_t* dest, const uint32_t* src, int count) {
+  const __m128i zero = _mm_setzero_si128();
+  int i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128i* d = reinterpret_cast<__m128i*>(dest + i);
+    __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i x = _mm_loadu_si128(d);
+    __m128i lo = MultiplyInverseAlpha(_mm_unpacklo_epi8(x, zero),
+                                      _mm_unpacklo_epi8(s, zero));
+    __m128i hi = MultiplyInverseAlpha(_mm_unpackhi_epi8(x, zero),
+                                      _mm_unpackhi_epi8(s, zero));
+    _mm_storeu_si128(d, _mm_adds_epu8(s, _mm_packus_epi16(lo, hi)));
+  }
+  BlendScalar(dest + i, src + i, count - i);
+}
+
+void BoxBlurSSE2(const uint32_t* src, uint32_t* dest, int count, int step,
+                 int radius) {
+  // All channels of a pixel are summed in one vector.
+  auto at = [=](int i) {
+    return UnpackPixel(src[
+        static_cast<ptrdiff_t>(std::min(std::max(i, 0), count - 1)) * step]);
+  };
+  __m128i sum = _mm_setzero_si128();
+  for (int i = -radius; i <= radius; ++i)
+    sum = _mm_add_epi32(sum, at(i));
+  __m128 scale = _mm_set1_ps(1.f / (2 * radius + 1));
+  for (int i = 0; i < count; ++i) {
+    dest[static_cast<ptrdiff_t>(i) * step] =
+        PackPixel(_mm_mul_ps(_mm_cvtepi32_ps(sum), scale));
+    sum = _mm_add_epi32(sum, at(i + radius + 1));
+    sum = _mm_sub_epi32(sum, at(i - radius));
+  }
+}
+
+}  // namespace
+
+void FillSSE2Kernels(PixelKernels* kernels) {
+  kernels->premultiply = &PremultiplySSE2;
+  kernels->color_matrix = &ColorMatrixSSE2;
+  kernels->blend = &BlendSSE2;
+  kernels->box_blur = &BoxBlurSSE2;
+}
+
+}  // namespace internal
+
+}  // namespace nu
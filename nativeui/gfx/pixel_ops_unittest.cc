@@ -0,0 +1,170 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <vector>
+
+#include "nativeui/gfx/pixel_ops.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// A 64x32 red PNG.
+const unsigned char kPNG[] = {
+  0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d,
+  0x49, 0x48, 0x44, 0x52, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x20,
+  0x08, 0x06, 0x00, 0x00, 0x00, 0xa2, 0x9d, 0x7e, 0x84, 0x00, 0x00, 0x00,
+  0x3d, 0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0xed, 0xd0, 0x31, 0x01, 0x00,
+  0x00, 0x08, 0xc0, 0xa0, 0xf5, 0x2f, 0xad, 0x3d, 0x94, 0x83, 0x02, 0x34,
+  0x35, 0x9f, 0x25, 0x40, 0x80, 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20,
+  0x40, 0x80, 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00,
+  0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00, 0x01, 0x02, 0x04,
+  0xdc, 0xb7, 0x20, 0xf2, 0xf0, 0xe2, 0x6e, 0x5c, 0x51, 0x71, 0x00, 0x00,
+  0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82,
+};
+
+// Fill the canvas with pseudo random premultiplied pixels.
+void FillCanvas(nu::Canvas* canvas, unsigned seed) {
+  nu::Canvas::Pixels pixels;
+  ASSERT_TRUE(canvas->LockPixels(&pixels));
+  srand(seed);
+  for (int y = 0; y < pixels.height; ++y) {
+    uint32_t* row = reinterpret_cast<uint32_t*>(
+        static_cast<uint8_t*>(pixels.data) + y * pixels.stride);
+    for (int x = 0; x < pixels.width; ++x)
+      row[x] = (rand() & 0xFFFF) | ((rand() & 0xFFFF) << 16);
+    nu::PixelOps::Premultiply(row, pixels.width);
+  }
+  canvas->UnlockPixels();
+}
+
+std::vector<uint32_t> ReadCanvas(nu::Canvas* canvas) {
+  std::vector<uint32_t> result;
+  nu::Canvas::Pixels pixels;
+  if (!canvas->LockPixels(&pixels))
+    return result;
+  for (int y = 0; y < pixels.height; ++y) {
+    uint32_t* row = reinterpret_cast<uint32_t*>(
+        static_cast<uint8_t*>(pixels.data) + y * pixels.stride);
+    result.insert(result.end(), row, row + pixels.width);
+  }
+  canvas->UnlockPixels();
+  return result;
+}
+
+}  // namespace
+
+class PixelOpsTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    best_ = nu::PixelOps::GetInstructionSet();
+  }
+
+  void TearDown() override {
+    nu::PixelOps::SetInstructionSet(best_);
+  }
+
+  // Run |op| on the same canvas with scalar and the best kernels.
+  template<typename Op>
+  void ExpectSameAsScalar(const Op& op) {
+    std::vector<uint32_t> results[2];
+    nu::PixelOps::InstructionSet sets[2] = {
+        nu::PixelOps::InstructionSet::Scalar, best_ };
+    for (int i = 0; i < 2; ++i) {
+      nu::PixelOps::SetInstructionSet(sets[i]);
+      scoped_refptr<nu::Canvas> canvas(new nu::Canvas(nu::SizeF(37, 23), 1.f));
+      FillCanvas(canvas.get(), 1);
+      ASSERT_TRUE(op(canvas.get()));
+      results[i] = ReadCanvas(canvas.get());
+    }
+    EXPECT_EQ(results[0], results[1]);
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  nu::PixelOps::InstructionSet best_;
+};
+
+TEST_F(PixelOpsTest, SetInstructionSet) {
+  nu::PixelOps::SetInstructionSet(nu::PixelOps::InstructionSet::Scalar);
+  EXPECT_EQ(nu::PixelOps::GetInstructionSet(),
+            nu::PixelOps::InstructionSet::Scalar);
+  // Capped to what CPU supports.
+  nu::PixelOps::SetInstructionSet(nu::PixelOps::InstructionSet::AVX2);
+  EXPECT_EQ(nu::PixelOps::GetInstructionSet(), best_);
+}
+
+TEST_F(PixelOpsTest, Premultiply) {
+  uint32_t pixels[] = { 0xFFFFFFFF, 0x80FF8000, 0x00FFFFFF, 0x40404040 };
+  nu::PixelOps::Premultiply(pixels, 4);
+  EXPECT_EQ(pixels[0], 0xFFFFFFFF);
+  EXPECT_EQ(pixels[1], 0x80804000);
+  EXPECT_EQ(pixels[2], 0x00000000);
+  EXPECT_EQ(pixels[3], 0x40101010);
+  nu::PixelOps::Unpremultiply(pixels, 4);
+  EXPECT_EQ(pixels[0], 0xFFFFFFFF);
+  EXPECT_EQ(pixels[1], 0x80FF8000);
+  EXPECT_EQ(pixels[2], 0x00000000);
+  EXPECT_EQ(pixels[3], 0x40404040);
+}
+
+TEST_F(PixelOpsTest, BoxBlur) {
+  ExpectSameAsScalar([](nu::Canvas* canvas) {
+    return nu::PixelOps::BoxBlur(canvas, 3);
+  });
+}
+
+TEST_F(PixelOpsTest, ApplyColorMatrix) {
+  // Grayscale.
+  std::vector<float> matrix = {
+    0.3f, 0.59f, 0.11f, 0, 0,
+    0.3f, 0.59f, 0.11f, 0, 0,
+    0.3f, 0.59f, 0.11f, 0, 0,
+    0, 0, 0, 1, 0,
+  };
+  ExpectSameAsScalar([&matrix](nu::Canvas* canvas) {
+    return nu::PixelOps::ApplyColorMatrix(canvas, matrix);
+  });
+  scoped_refptr<nu::Canvas> canvas(new nu::Canvas(nu::SizeF(1, 1), 1.f));
+  EXPECT_FALSE(nu::PixelOps::ApplyColorMatrix(canvas.get(), {1, 2, 3}));
+}
+
+TEST_F(PixelOpsTest, Blend) {
+  scoped_refptr<nu::Canvas> src(new nu::Canvas(nu::SizeF(37, 23), 1.f));
+  FillCanvas(src.get(), 2);
+  ExpectSameAsScalar([&src](nu::Canvas* canvas) {
+    return nu::PixelOps::Blend(canvas, src.get());
+  });
+  scoped_refptr<nu::Canvas> small(new nu::Canvas(nu::SizeF(1, 1), 1.f));
+  EXPECT_FALSE(nu::PixelOps::Blend(small.get(), src.get()));
+  EXPECT_FALSE(nu::PixelOps::Blend(src.get(), src.get()));
+}
+
+TEST_F(PixelOpsTest, CreateCanvasFromImage) {
+  scoped_refptr<nu::Image> image =
+      nu::Image::CreateFromBuffer(nu::Buffer(kPNG, sizeof(kPNG)), 2.f);
+  ASSERT_TRUE(image);
+  scoped_refptr<nu::Canvas> canvas =
+      nu::PixelOps::CreateCanvasFromImage(image.get());
+  EXPECT_EQ(canvas->GetSize(), nu::SizeF(32, 16));
+  EXPECT_EQ(canvas->GetScaleFactor(), 2.f);
+  // Swap the red and green channels.
+  std::vector<float> matrix = {
+    0, 1, 0, 0, 0,
+    1, 0, 0, 0, 0,
+    0, 0, 1, 0, 0,
+    0, 0, 0, 1, 0,
+  };
+  ASSERT_TRUE(nu::PixelOps::ApplyColorMatrix(canvas.get(), matrix));
+  std::vector<uint32_t> pixels = ReadCanvas(canvas.get());
+  ASSERT_EQ(pixels.size(), 64u * 32u);
+#if !defined(OS_MACOSX)
+  // Drawing on macOS goes through color space conversion.
+  for (uint32_t pixel : pixels)
+    ASSERT_EQ(pixel, 0xFF00FF00);
+#endif
+}
@@ -36,4 +36,30 @@ Painter* Canvas::PlatformCreatePainter(NativeBitmap bitmap,
   return new PainterWin(bitmap, scale_factor);
 }
 
+bool Canvas::PlatformLockPixels(Pixels* pixels) {
+  // Locking with the same format of the bitmap gives direct access to the
+  // pixels without conversion.
+  Gdiplus::Rect rect(0, 0, bitmap_->GetWidth(), bitmap_->GetHeight());
+  lock_data_ = new Gdiplus::BitmapData;
+  if (bitmap_->LockBits(&rect,
+                        Gdiplus::ImageLockModeRead | Gdiplus::ImageLockModeWrite,
+                        PixelFormat32bppARGB, lock_data_) != Gdiplus::Ok) {
+    delete lock_data_;
+    lock_data_ = nullptr;
+    return false;
+  }
+  pixels->data = lock_data_->Scan0;
+  pixels->width = static_cast<int>(lock_data_->Width);
+  pixels->height = static_cast<int>(lock_data_->Height);
+  pixels->stride = lock_data_->Stride;
+  pixels->format = Pixels::Format::ARGB;
+  return true;
+}
+
+void Canvas::PlatformUnlockPixels() {
+  bitmap_->UnlockBits(lock_data_);
+  delete lock_data_;
+  lock_data_ = nullptr;
+}
+
 }  // namespace nu
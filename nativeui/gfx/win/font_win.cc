@@ -51,6 +51,7 @@ Font::Font(const std::string& name, float size, Weight weight, Style style) {
 }
 
 Font::~Font() {
+  Uncache();
   delete font_;
 }
 
@@ -4,18 +4,28 @@
 
 #include "nativeui/gfx/image.h"
 
+#include <shlwapi.h>
+
+#include <unordered_map>
+
+#include "base/lazy_instance.h"
+#include "base/synchronization/lock.h"
 #include "nativeui/gfx/win/gdiplus.h"
 
 namespace nu {
 
-Image::Image(const base::FilePath& path)
-    : scale_factor_(GetScaleFactorFromFilePath(path)),
-      image_(new Gdiplus::Image(path.value().c_str())) {
-}
+namespace {
 
-Image::~Image() {
-  delete image_;
-}
+// GDI+ images are not reference counted, so the references added by
+// PlatformRetain are counted here and the image is shared instead of copied.
+struct ImageRefs {
+  base::Lock lock;
+  std::unordered_map<Gdiplus::Image*, int> extra_refs;
+};
+
+base::LazyInstance<ImageRefs>::Leaky g_image_refs = LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
 
 SizeF Image::GetSize() const {
   Gdiplus::Image* image = const_cast<Gdiplus::Image*>(image_);
@@ -27,4 +37,90 @@ NativeImage Image::GetNative() const {
   return image_;
 }
 
+// static
+NativeImage Image::PlatformDecode(const base::FilePath& path,
+                                  const SizeF& max_size,
+                                  float* scale_factor) {
+  *scale_factor = GetScaleFactorFromFilePath(path);
+  Gdiplus::Image* image = new Gdiplus::Image(path.value().c_str());
+  if (image->GetLastStatus() != Gdiplus::Ok) {
+    delete image;
+    return nullptr;
+  }
+  Size target;
+  if (!GetScaledDownSize(Size(image->GetWidth(), image->GetHeight()),
+                         *scale_factor, max_size, &target))
+    return image;
+  // GDI+ can not decode at a smaller size, so draw it into a small bitmap and
+  // release the full size one.
+  Gdiplus::Bitmap* bitmap = new Gdiplus::Bitmap(target.width(),
+                                                target.height(),
+                                                PixelFormat32bppPARGB);
+  {
+    Gdiplus::Graphics graphics(bitmap);
+    graphics.SetInterpolationMode(Gdiplus::InterpolationModeHighQualityBicubic);
+    graphics.SetPixelOffsetMode(Gdiplus::PixelOffsetModeHalf);
+    graphics.DrawImage(image, 0, 0, target.width(), target.height());
+  }
+  delete image;
+  return bitmap;
+}
+
+// static
+NativeImage Image::PlatformDecodeBuffer(const Buffer& buffer,
+                                        float scale_factor) {
+  IStream* stream = SHCreateMemStream(
+      static_cast<const BYTE*>(buffer.content()),
+      static_cast<UINT>(buffer.size()));
+  if (!stream)
+    return nullptr;
+  // The image decoded from stream keeps reading the stream, copy the pixels
+  // so the stream can be released.
+  Gdiplus::Bitmap* bitmap = nullptr;
+  {
+    Gdiplus::Image image(stream);
+    if (image.GetLastStatus() == Gdiplus::Ok) {
+      bitmap = new Gdiplus::Bitmap(image.GetWidth(), image.GetHeight(),
+                                   PixelFormat32bppPARGB);
+      Gdiplus::Graphics graphics(bitmap);
+      graphics.DrawImage(&image, 0, 0, image.GetWidth(), image.GetHeight());
+    }
+  }
+  stream->Release();
+  return bitmap;
+}
+
+// static
+NativeImage Image::PlatformCreateEmpty() {
+  return new Gdiplus::Bitmap(1, 1, PixelFormat32bppARGB);
+}
+
+// static
+NativeImage Image::PlatformRetain(NativeImage image) {
+  ImageRefs& refs = g_image_refs.Get();
+  base::AutoLock auto_lock(refs.lock);
+  refs.extra_refs[image]++;
+  return image;
+}
+
+// static
+void Image::PlatformRelease(NativeImage image) {
+  {
+    ImageRefs& refs = g_image_refs.Get();
+    base::AutoLock auto_lock(refs.lock);
+    auto it = refs.extra_refs.find(image);
+    if (it != refs.extra_refs.end()) {
+      if (--it->second == 0)
+        refs.extra_refs.erase(it);
+      return;
+    }
+  }
+  delete image;
+}
+
+// static
+int Image::PlatformGetMemoryUsage(NativeImage image) {
+  return static_cast<int>(image->GetWidth() * image->GetHeight() * 4);
+}
+
 }  // namespace nu
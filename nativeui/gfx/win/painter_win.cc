@@ -18,6 +18,7 @@
 #include "nativeui/gfx/geometry/rect_conversions.h"
 #include "nativeui/gfx/geometry/vector2d_conversions.h"
 #include "nativeui/gfx/image.h"
+#include "nativeui/gfx/path.h"
 #include "nativeui/state.h"
 
 namespace nu {
@@ -172,6 +173,26 @@ void PainterWin::Fill() {
   path_.Reset();
 }
 
+void PainterWin::StrokePath(Path* path) {
+  Gdiplus::Pen pen(ToGdi(top().stroke_color), top().line_width);
+  graphics_.DrawPath(&pen, ScalePath(path).get());
+  use_gdi_current_point_ = true;
+  path_.Reset();
+}
+
+void PainterWin::FillPath(Path* path) {
+  Gdiplus::SolidBrush brush(ToGdi(top().fill_color));
+  graphics_.FillPath(&brush, ScalePath(path).get());
+  use_gdi_current_point_ = true;
+  path_.Reset();
+}
+
+void PainterWin::ClipPath(Path* path) {
+  graphics_.SetClip(ScalePath(path).get(), Gdiplus::CombineModeIntersect);
+  use_gdi_current_point_ = true;
+  path_.Reset();
+}
+
 void PainterWin::StrokeRect(const RectF& rect) {
   StrokeRectPixel(ToEnclosingRect(ScaleRect(rect, scale_factor_)));
 }
@@ -355,6 +376,14 @@ bool PainterWin::GetCurrentPoint(Gdiplus::PointF* point) {
   return true;
 }
 
+std::unique_ptr<Gdiplus::GraphicsPath> PainterWin::ScalePath(Path* path) {
+  std::unique_ptr<Gdiplus::GraphicsPath> scaled(path->GetNative()->Clone());
+  Gdiplus::Matrix matrix;
+  matrix.Scale(scale_factor_, scale_factor_);
+  scaled->Transform(&matrix);
+  return scaled;
+}
+
 HDC PainterWin::GetHDC() {
   // Get the clip region of graphics.
   Gdiplus::Region clip;
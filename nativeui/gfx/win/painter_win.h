@@ -5,6 +5,7 @@
 #ifndef NATIVEUI_GFX_WIN_PAINTER_WIN_H_
 #define NATIVEUI_GFX_WIN_PAINTER_WIN_H_
 
+#include <memory>
 #include <stack>
 #include <string>
 
@@ -55,6 +56,9 @@ class PainterWin : public Painter {
   void SetLineWidth(float width) override;
   void Stroke() override;
   void Fill() override;
+  void StrokePath(Path* path) override;
+  void FillPath(Path* path) override;
+  void ClipPath(Path* path) override;
   void StrokeRect(const RectF& rect) override;
   void FillRect(const RectF& rect) override;
   void DrawImage(Image* image, const RectF& rect) override;
@@ -91,6 +95,9 @@ class PainterWin : public Painter {
   // Get current point.
   bool GetCurrentPoint(Gdiplus::PointF* point);
 
+  // Return a copy of |path| converted to pixels.
+  std::unique_ptr<Gdiplus::GraphicsPath> ScalePath(Path* path);
+
   // Receive the HDC that can be painted on.
   HDC GetHDC();
   void ReleaseHDC(HDC dc);
@@ -0,0 +1,38 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/path.h"
+
+#include "nativeui/gfx/win/gdiplus.h"
+
+namespace nu {
+
+void Path::PlatformInit() {
+  path_ = new Gdiplus::GraphicsPath;
+}
+
+void Path::PlatformDestroy() {
+  delete path_;
+}
+
+void Path::PlatformMoveTo(const PointF& point) {
+  path_->StartFigure();
+}
+
+void Path::PlatformLineTo(const PointF& point) {
+  // GDI+ has no current point, segments are added with their start points.
+  path_->AddLine(ToGdi(current_point_), ToGdi(point));
+}
+
+void Path::PlatformBezierCurveTo(const PointF& cp1,
+                                 const PointF& cp2,
+                                 const PointF& ep) {
+  path_->AddBezier(ToGdi(current_point_), ToGdi(cp1), ToGdi(cp2), ToGdi(ep));
+}
+
+void Path::PlatformClosePath() {
+  path_->CloseFigure();
+}
+
+}  // namespace nu
@@ -7,7 +7,13 @@
 #include <JavaScriptCore/JavaScript.h>
 #include <webkit2/webkit2.h>
 
-#include "base/json/json_reader.h"
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "base/memory/ptr_util.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/values.h"
 #include "nativeui/gtk/nu_protocol_stream.h"
 #include "nativeui/gtk/widget_util.h"
 
@@ -17,29 +23,246 @@ namespace {
 
 const char* kIgnoreNextFinish = "ignore-next-finish";
 
+// Same with the default max depth of base::JSONReader, which also stops
+// walking into cyclic objects.
+const int kMaxValueDepth = 200;
+
 std::string JSStringToString(JSStringRef js) {
-  size_t max_size = JSStringGetMaximumUTF8CStringSize(js);
-  std::string str(max_size, '\0');
-  JSStringGetUTF8CString(js, &str[0], max_size);
-  size_t length = strlen(str.c_str());
-  str.erase(length, max_size - length);
-  return str;
+  return base::UTF16ToUTF8(base::StringPiece16(
+      reinterpret_cast<const base::char16*>(JSStringGetCharactersPtr(js)),
+      JSStringGetLength(js)));
 }
 
+// Convert JS values to base::Value by walking the value graph directly, the
+// result is the same with converting through JSON.stringify: undefined and
+// functions are omitted in objects and become null in arrays, non-finite
+// numbers become null, toJSON methods are respected, and only own enumerable
+// properties of objects are kept. The exception is that ArrayBuffer and typed
+// arrays are converted to binary values.
+class JSValueConverter {
+ public:
+  explicit JSValueConverter(JSContextRef context)
+      : context_(context),
+        to_json_(JSStringCreateWithUTF8CString("toJSON")),
+        length_(JSStringCreateWithUTF8CString("length")),
+        has_own_property_(GetHasOwnProperty()) {}
+
+  ~JSValueConverter() {
+    JSStringRelease(to_json_);
+    JSStringRelease(length_);
+    if (has_own_property_)
+      JSValueUnprotect(context_, has_own_property_);
+  }
+
+  // Return false if the value can not be converted, for example when it has
+  // cycles or a getter throws.
+  bool Convert(JSValueRef value, base::Value* out) {
+    return Convert(value, 0, out);
+  }
+
+ private:
+  // Return Object.prototype.hasOwnProperty, which is protected from GC.
+  JSObjectRef GetHasOwnProperty() {
+    JSStringRef script =
+        JSStringCreateWithUTF8CString("Object.prototype.hasOwnProperty");
+    JSValueRef value = JSEvaluateScript(context_, script, nullptr, nullptr, 0,
+                                        nullptr);
+    JSStringRelease(script);
+    if (!value || !JSValueIsObject(context_, value))
+      return nullptr;
+    JSObjectRef func = JSValueToObject(context_, value, nullptr);
+    JSValueProtect(context_, func);
+    return func;
+  }
+
+  // JSObjectCopyPropertyNames also returns enumerable properties of the
+  // prototype chain, which are ignored by JSON.stringify.
+  bool IsOwnProperty(JSObjectRef object, JSStringRef name,
+                     JSValueRef* exception) {
+    if (!has_own_property_)
+      return true;
+    JSValueRef arg = JSValueMakeString(context_, name);
+    JSValueRef result = JSObjectCallAsFunction(context_, has_own_property_,
+                                               object, 1, &arg, exception);
+    return result && JSValueToBoolean(context_, result);
+  }
+
+  // Whether the value is skipped by JSON.stringify.
+  bool IsSkipped(JSValueRef value) {
+    if (JSValueIsUndefined(context_, value))
+      return true;
+    if (!JSValueIsObject(context_, value))
+      return false;
+    return JSObjectIsFunction(context_, JSValueToObject(context_, value,
+                                                        nullptr));
+  }
+
+  bool Convert(JSValueRef value, int depth, base::Value* out) {
+    if (depth > kMaxValueDepth)
+      return false;
+    switch (JSValueGetType(context_, value)) {
+      case kJSTypeUndefined:
+      case kJSTypeNull:
+        *out = base::Value();
+        return true;
+      case kJSTypeBoolean:
+        *out = base::Value(JSValueToBoolean(context_, value));
+        return true;
+      case kJSTypeNumber:
+        *out = NumberToValue(JSValueToNumber(context_, value, nullptr));
+        return true;
+      case kJSTypeString: {
+        JSStringRef str = JSValueToStringCopy(context_, value, nullptr);
+        *out = base::Value(JSStringToString(str));
+        JSStringRelease(str);
+        return true;
+      }
+      case kJSTypeObject:
+        return ConvertObject(value, depth, out);
+      default:
+        *out = base::Value();
+        return true;
+    }
+  }
+
+  bool ConvertObject(JSValueRef value, int depth, base::Value* out) {
+    JSValueRef exception = nullptr;
+    JSObjectRef object = JSValueToObject(context_, value, &exception);
+    if (exception)
+      return false;
+    // ArrayBuffer and typed arrays become binary values.
+    JSTypedArrayType typed_array_type =
+        JSValueGetTypedArrayType(context_, value, nullptr);
+    if (typed_array_type != kJSTypedArrayTypeNone) {
+      *out = ToBinary(object, typed_array_type);
+      return true;
+    }
+    // Objects like Date are converted by their toJSON methods.
+    JSValueRef to_json = JSObjectGetProperty(context_, object, to_json_,
+                                             &exception);
+    if (exception)
+      return false;
+    if (JSValueIsObject(context_, to_json)) {
+      JSObjectRef func = JSValueToObject(context_, to_json, nullptr);
+      if (JSObjectIsFunction(context_, func)) {
+        JSValueRef result = JSObjectCallAsFunction(context_, func, object, 0,
+                                                   nullptr, &exception);
+        if (exception)
+          return false;
+        return Convert(result, depth + 1, out);
+      }
+    }
+
+    if (JSValueIsArray(context_, value)) {
+      JSValueRef length = JSObjectGetProperty(context_, object, length_,
+                                              &exception);
+      if (exception)
+        return false;
+      unsigned size = static_cast<unsigned>(
+          JSValueToNumber(context_, length, nullptr));
+      std::vector<base::Value> list;
+      list.reserve(size);
+      for (unsigned i = 0; i < size; ++i) {
+        JSValueRef element = JSObjectGetPropertyAtIndex(context_, object, i,
+                                                        &exception);
+        if (exception)
+          return false;
+        list.emplace_back();
+        if (!IsSkipped(element) &&
+            !Convert(element, depth + 1, &list.back()))
+          return false;
+      }
+      *out = base::Value(std::move(list));
+      return true;
+    }
+
+    if (JSObjectIsFunction(context_, object)) {
+      *out = base::Value();
+      return true;
+    }
+
+    base::DictionaryValue dict;
+    JSPropertyNameArrayRef names = JSObjectCopyPropertyNames(context_, object);
+    size_t count = JSPropertyNameArrayGetCount(names);
+    bool success = true;
+    for (size_t i = 0; i < count; ++i) {
+      JSStringRef name = JSPropertyNameArrayGetNameAtIndex(names, i);
+      bool is_own = IsOwnProperty(object, name, &exception);
+      if (exception) {
+        success = false;
+        break;
+      }
+      if (!is_own)
+        continue;
+      JSValueRef property = JSObjectGetProperty(context_, object, name,
+                                                &exception);
+      if (exception) {
+        success = false;
+        break;
+      }
+      if (IsSkipped(property))
+        continue;
+      base::Value child;
+      if (!Convert(property, depth + 1, &child)) {
+        success = false;
+        break;
+      }
+      dict.SetWithoutPathExpansion(
+          JSStringToString(name),
+          base::MakeUnique<base::Value>(std::move(child)));
+    }
+    JSPropertyNameArrayRelease(names);
+    if (success)
+      *out = std::move(dict);
+    return success;
+  }
+
+  base::Value ToBinary(JSObjectRef object, JSTypedArrayType type) {
+    JSObjectRef buffer = object;
+    size_t offset = 0;
+    size_t length = 0;
+    if (type == kJSTypedArrayTypeArrayBuffer) {
+      length = JSObjectGetArrayBufferByteLength(context_, object, nullptr);
+    } else {
+      buffer = JSObjectGetTypedArrayBuffer(context_, object, nullptr);
+      offset = JSObjectGetTypedArrayByteOffset(context_, object, nullptr);
+      length = JSObjectGetTypedArrayByteLength(context_, object, nullptr);
+    }
+    const char* bytes = static_cast<const char*>(
+        JSObjectGetArrayBufferBytesPtr(context_, buffer, nullptr));
+    if (!bytes || length == 0)
+      return base::Value(std::vector<char>());
+    return base::Value(std::vector<char>(bytes + offset,
+                                         bytes + offset + length));
+  }
+
+  // Follow base::JSONReader, which parses integers that fit in int as int.
+  static base::Value NumberToValue(double number) {
+    if (!std::isfinite(number))
+      return base::Value();
+    if (number >= std::numeric_limits<int>::min() &&
+        number <= std::numeric_limits<int>::max() &&
+        number == std::floor(number))
+      return base::Value(static_cast<int>(number));
+    return base::Value(number);
+  }
+
+  JSContextRef context_;
+  JSStringRef to_json_;
+  JSStringRef length_;
+  JSObjectRef has_own_property_;
+
+  DISALLOW_COPY_AND_ASSIGN(JSValueConverter);
+};
+
 base::Value JSResultToBaseValue(WebKitJavascriptResult* js_result) {
-  auto* context = webkit_javascript_result_get_global_context(js_result);
-  auto* value = webkit_javascript_result_get_value(js_result);
-  // While manually iterating the value should be more efficient, their API is
-  // such a pain to use.
-  JSStringRef json = JSValueCreateJSONString(context, value, 0, nullptr);
-  if (!json)
-    return base::Value();
-  std::string json_str = JSStringToString(json);
-  JSStringRelease(json);
-  std::unique_ptr<base::Value> result = base::JSONReader::Read(json_str);
-  if (!result)
+  JSValueConverter converter(
+      webkit_javascript_result_get_global_context(js_result));
+  base::Value result;
+  if (!converter.Convert(webkit_javascript_result_get_value(js_result),
+                         &result))
     return base::Value();
-  return std::move(*result.release());
+  return result;
 }
 
 void OnNotifyTitle(WebKitWebView*, GParamSpec*, Browser* view) {
@@ -5,16 +5,294 @@
 #include "nativeui/message_loop.h"
 
 #include <gtk/gtk.h>
+#include <stdint.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
 
+#include <atomic>
+#include <utility>
+#include <vector>
+
+#include "base/lazy_instance.h"
+#include "base/logging.h"
+#include "base/macros.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/synchronization/lock.h"
 #include "nativeui/gtk/widget_util.h"
+#include "nativeui/util/timer_wheel.h"
+#include "nativeui/window.h"
 
 namespace nu {
 
 namespace {
 
-gboolean OnSource(std::function<void()>* func) {
-  (*func)();
-  return G_SOURCE_REMOVE;
+// Maximum number of tasks to run in one dispatch, so a flood of tasks from
+// worker threads would not starve input events.
+const int kMaxTasksPerDispatch = 256;
+
+// An intrusive multi-producer single-consumer queue, pushing never takes a
+// lock and popping is only done on the GUI thread.
+class TaskQueue {
+ public:
+  TaskQueue() : head_(&stub_), tail_(&stub_) {}
+
+  ~TaskQueue() {
+    while (Node* node = Pop())
+      delete node;
+  }
+
+  void Push(MessageLoop::Task task) {
+    Push(new Node(std::move(task)));
+  }
+
+  // Return false if there is no task available.
+  bool Pop(MessageLoop::Task* task) {
+    Node* node = Pop();
+    if (!node)
+      return false;
+    *task = std::move(node->task);
+    delete node;
+    return true;
+  }
+
+ private:
+  struct Node {
+    Node() : next(nullptr) {}
+    explicit Node(MessageLoop::Task task)
+        : next(nullptr), task(std::move(task)) {}
+
+    std::atomic<Node*> next;
+    MessageLoop::Task task;
+  };
+
+  void Push(Node* node) {
+    node->next.store(nullptr, std::memory_order_relaxed);
+    Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+  }
+
+  Node* Pop() {
+    Node* tail = tail_;
+    Node* next = tail->next.load(std::memory_order_acquire);
+    if (tail == &stub_) {
+      if (!next)
+        return nullptr;
+      tail_ = next;
+      tail = next;
+      next = next->next.load(std::memory_order_acquire);
+    }
+    if (next) {
+      tail_ = next;
+      return tail;
+    }
+    // A producer is in the middle of pushing, it will wake us up again.
+    if (tail != head_.load(std::memory_order_acquire))
+      return nullptr;
+    Push(&stub_);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next) {
+      tail_ = next;
+      return tail;
+    }
+    return nullptr;
+  }
+
+  std::atomic<Node*> head_;  // producers
+  Node* tail_;  // consumer
+  Node stub_;
+
+  DISALLOW_COPY_AND_ASSIGN(TaskQueue);
+};
+
+// A GSource that runs tasks posted from any thread, the loop is only woken up
+// once for all the tasks posted before next dispatch.
+class TaskSource {
+ public:
+  TaskSource() : wakeup_fd_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {
+    PCHECK(wakeup_fd_ >= 0);
+    source_ = g_source_new(&source_funcs_, sizeof(SourceWrapper));
+    reinterpret_cast<SourceWrapper*>(source_)->self = this;
+    fd_tag_ = g_source_add_unix_fd(source_, wakeup_fd_, G_IO_IN);
+    g_source_set_priority(source_, G_PRIORITY_DEFAULT);
+    g_source_set_can_recurse(source_, TRUE);
+    g_source_attach(source_, nullptr);
+  }
+
+  void PostTask(MessageLoop::Task task) {
+    queue_.Push(std::move(task));
+    if (!wakeup_pending_.exchange(true, std::memory_order_acq_rel)) {
+      uint64_t one = 1;
+      ssize_t ret = HANDLE_EINTR(write(wakeup_fd_, &one, sizeof(one)));
+      DPCHECK(ret == sizeof(one));
+    }
+  }
+
+ private:
+  struct SourceWrapper {
+    GSource source;
+    TaskSource* self;
+  };
+
+  static gboolean OnDispatch(GSource* source, GSourceFunc, gpointer) {
+    reinterpret_cast<SourceWrapper*>(source)->self->RunTasks();
+    return G_SOURCE_CONTINUE;
+  }
+
+  void RunTasks() {
+    if (g_source_query_unix_fd(source_, fd_tag_) & G_IO_IN) {
+      uint64_t count;
+      ignore_result(HANDLE_EINTR(read(wakeup_fd_, &count, sizeof(count))));
+    }
+    // Tasks posted from now on must wake up the loop again.
+    wakeup_pending_.store(false, std::memory_order_release);
+    for (int i = 0; i < kMaxTasksPerDispatch; ++i) {
+      MessageLoop::Task task;
+      if (!queue_.Pop(&task)) {
+        g_source_set_ready_time(source_, -1);
+        return;
+      }
+      task();
+    }
+    // Run the remaining tasks in next iteration.
+    g_source_set_ready_time(source_, 0);
+  }
+
+  static GSourceFuncs source_funcs_;
+
+  TaskQueue queue_;
+  std::atomic<bool> wakeup_pending_{false};
+  int wakeup_fd_;
+  GSource* source_;
+  gpointer fd_tag_;
+
+  DISALLOW_COPY_AND_ASSIGN(TaskSource);
+};
+
+// static
+GSourceFuncs TaskSource::source_funcs_ = {
+  nullptr, nullptr, TaskSource::OnDispatch, nullptr,
+};
+
+base::LazyInstance<TaskSource>::Leaky g_task_source =
+    LAZY_INSTANCE_INITIALIZER;
+
+// A GSource that runs all delayed tasks, the tasks are managed by a timer
+// wheel instead of creating one GSource for each task.
+class TimerSource {
+ public:
+  TimerSource() : wheel_(GetNow()) {
+    source_ = g_source_new(&source_funcs_, sizeof(SourceWrapper));
+    reinterpret_cast<SourceWrapper*>(source_)->self = this;
+    g_source_set_priority(source_, G_PRIORITY_DEFAULT);
+    g_source_set_can_recurse(source_, TRUE);
+    g_source_attach(source_, nullptr);
+  }
+
+  MessageLoop::TimerId PostDelayedTask(int ms, MessageLoop::Task task) {
+    base::AutoLock auto_lock(lock_);
+    int64_t now = GetNow();
+    MessageLoop::TimerId id = wheel_.Add(now, ms, std::move(task));
+    WakeupAt(now + ms);
+    return id;
+  }
+
+  void Cancel(MessageLoop::TimerId id) {
+    // Waking up earlier than needed is harmless, so leave the ready time.
+    base::AutoLock auto_lock(lock_);
+    wheel_.Cancel(id);
+  }
+
+  void Reset(MessageLoop::TimerId id) {
+    base::AutoLock auto_lock(lock_);
+    if (wheel_.Reset(GetNow(), id))
+      WakeupAt(wheel_.GetNextWakeup());
+  }
+
+ private:
+  struct SourceWrapper {
+    GSource source;
+    TimerSource* self;
+  };
+
+  // The time used by timer wheel, in milliseconds.
+  static int64_t GetNow() {
+    return g_get_monotonic_time() / 1000;
+  }
+
+  static gboolean OnDispatch(GSource* source, GSourceFunc, gpointer) {
+    reinterpret_cast<SourceWrapper*>(source)->self->RunTasks();
+    return G_SOURCE_CONTINUE;
+  }
+
+  void RunTasks() {
+    {
+      base::AutoLock auto_lock(lock_);
+      wheel_.Advance(GetNow());
+    }
+    for (int i = 0; i < kMaxTasksPerDispatch; ++i) {
+      MessageLoop::Task task;
+      {
+        base::AutoLock auto_lock(lock_);
+        if (!wheel_.PopExpired(&task))
+          break;
+      }
+      task();
+    }
+    base::AutoLock auto_lock(lock_);
+    wakeup_time_ = wheel_.GetNextWakeup();
+    g_source_set_ready_time(source_,
+                            wakeup_time_ < 0 ? -1 : wakeup_time_ * 1000);
+  }
+
+  // Make sure the source is dispatched no later than |time|.
+  void WakeupAt(int64_t time) {
+    lock_.AssertAcquired();
+    if (time < 0 || (wakeup_time_ >= 0 && wakeup_time_ <= time))
+      return;
+    wakeup_time_ = time;
+    g_source_set_ready_time(source_, time * 1000);
+  }
+
+  static GSourceFuncs source_funcs_;
+
+  base::Lock lock_;
+  TimerWheel wheel_;
+  int64_t wakeup_time_ = -1;
+  GSource* source_;
+
+  DISALLOW_COPY_AND_ASSIGN(TimerSource);
+};
+
+// static
+GSourceFuncs TimerSource::source_funcs_ = {
+  nullptr, nullptr, TimerSource::OnDispatch, nullptr,
+};
+
+base::LazyInstance<TimerSource>::Leaky g_timer_source =
+    LAZY_INSTANCE_INITIALIZER;
+
+// The frame callbacks requested for a window.
+struct FrameRequests {
+  std::vector<MessageLoop::FrameCallback> callbacks;
+  bool tick_added = false;
+};
+
+gboolean OnFrameTick(GtkWidget* widget,
+                     GdkFrameClock* frame_clock,
+                     FrameRequests* requests) {
+  // Callbacks requested from now on are for next frame.
+  std::vector<MessageLoop::FrameCallback> callbacks;
+  callbacks.swap(requests->callbacks);
+  double frame_time = gdk_frame_clock_get_frame_time(frame_clock) / 1000.;
+  // The requests are owned by widget, keep it alive when running callbacks.
+  g_object_ref(widget);
+  for (const auto& callback : callbacks)
+    callback(frame_time);
+  bool has_more = !requests->callbacks.empty();
+  if (!has_more)
+    requests->tick_added = false;
+  g_object_unref(widget);
+  return has_more ? G_SOURCE_CONTINUE : G_SOURCE_REMOVE;
 }
 
 }  // namespace
@@ -30,16 +308,42 @@ void MessageLoop::Quit() {
 }
 
 // static
-void MessageLoop::PostTask(const std::function<void()>& task) {
-  g_idle_add_full(G_PRIORITY_DEFAULT, reinterpret_cast<GSourceFunc>(OnSource),
-                  new Task(task), Delete<Task>);
+void MessageLoop::PostTask(Task task) {
+  g_task_source.Get().PostTask(std::move(task));
+}
+
+// static
+MessageLoop::TimerId MessageLoop::PostDelayedTask(int ms, Task task) {
+  return g_timer_source.Get().PostDelayedTask(ms, std::move(task));
+}
+
+// static
+void MessageLoop::CancelDelayedTask(TimerId id) {
+  g_timer_source.Get().Cancel(id);
+}
+
+// static
+void MessageLoop::ResetDelayedTask(TimerId id) {
+  g_timer_source.Get().Reset(id);
 }
 
 // static
-void MessageLoop::PostDelayedTask(int ms, const std::function<void()>& task) {
-  g_timeout_add_full(G_PRIORITY_DEFAULT, ms,
-                     reinterpret_cast<GSourceFunc>(OnSource),
-                     new Task(task), Delete<Task>);
+void MessageLoop::RequestFrame(Window* window, FrameCallback callback) {
+  GtkWidget* widget = GTK_WIDGET(window->GetNative());
+  auto* requests = static_cast<FrameRequests*>(
+      g_object_get_data(G_OBJECT(widget), "frame-requests"));
+  if (!requests) {
+    requests = new FrameRequests;
+    g_object_set_data_full(G_OBJECT(widget), "frame-requests", requests,
+                           Delete<FrameRequests>);
+  }
+  requests->callbacks.push_back(std::move(callback));
+  if (!requests->tick_added) {
+    requests->tick_added = true;
+    gtk_widget_add_tick_callback(
+        widget, reinterpret_cast<GtkTickCallback>(OnFrameTick), requests,
+        nullptr);
+  }
 }
 
 }  // namespace nu
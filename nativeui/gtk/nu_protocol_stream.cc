@@ -4,7 +4,10 @@
 
 #include "nativeui/gtk/nu_protocol_stream.h"
 
+#include <memory>
+
 #include "nativeui/protocol_job.h"
+#include "nativeui/thread_pool.h"
 
 namespace nu {
 
@@ -31,6 +34,50 @@ static gssize nu_protocol_stream_read(GInputStream* stream,
   return priv->protocol_job->Read(buffer, count);
 }
 
+static void nu_protocol_stream_read_async(GInputStream* stream,
+                                          void* buffer, gsize count,
+                                          int io_priority,
+                                          GCancellable* cancellable,
+                                          GAsyncReadyCallback callback,
+                                          gpointer user_data) {
+  NUProtocolStreamPrivate* priv = NU_PROTOCOL_STREAM(stream)->priv;
+  ProtocolJob* protocol_job = priv->protocol_job.get();
+  if (!protocol_job->IsReadThreadSafe()) {
+    // The default implementation calls read_fn on GIO's I/O threads, since
+    // the stream is not pollable.
+    G_INPUT_STREAM_CLASS(nu_protocol_stream_parent_class)->read_async(
+        stream, buffer, count, io_priority, cancellable, callback, user_data);
+    return;
+  }
+  GTask* task = g_task_new(stream, cancellable, callback, user_data);
+  g_task_set_source_tag(task,
+                        reinterpret_cast<void*>(nu_protocol_stream_read_async));
+  // The task keeps the stream and thus the job alive, and GIO does not allow
+  // another read before this one finishes, so reads never overlap.
+  auto nread = std::make_shared<gssize>(0);
+  ThreadPool::PostTaskAndReply(
+      [protocol_job, buffer, count, nread]() {
+        *nread = protocol_job->Read(buffer, count);
+      },
+      [task, nread]() {
+        g_task_return_int(task, *nread);
+        g_object_unref(task);
+      },
+      io_priority < G_PRIORITY_DEFAULT ? ThreadPool::Priority::High :
+      io_priority > G_PRIORITY_DEFAULT ? ThreadPool::Priority::Low :
+                                         ThreadPool::Priority::Normal);
+}
+
+static gssize nu_protocol_stream_read_finish(GInputStream* stream,
+                                             GAsyncResult* result,
+                                             GError** error) {
+  if (!g_async_result_is_tagged(
+          result, reinterpret_cast<void*>(nu_protocol_stream_read_async)))
+    return G_INPUT_STREAM_CLASS(nu_protocol_stream_parent_class)->read_finish(
+        stream, result, error);
+  return g_task_propagate_int(G_TASK(result), error);
+}
+
 static gboolean nu_protocol_stream_close(GInputStream* stream,
                                          GCancellable*, GError**) {
   return true;
@@ -42,6 +89,8 @@ static void nu_protocol_stream_class_init(NUProtocolStreamClass* klass) {
 
   GInputStreamClass* istream_class = G_INPUT_STREAM_CLASS(klass);
   istream_class->read_fn = nu_protocol_stream_read;
+  istream_class->read_async = nu_protocol_stream_read_async;
+  istream_class->read_finish = nu_protocol_stream_read_finish;
   istream_class->close_fn = nu_protocol_stream_close;
 }
 
@@ -6,8 +6,11 @@
 
 #include <gtk/gtk.h>
 
+#include <algorithm>
+
 #include "nativeui/gtk/undoable_text_buffer.h"
 #include "nativeui/gtk/widget_util.h"
+#include "nativeui/message_loop.h"
 
 namespace nu {
 
@@ -17,6 +20,22 @@ void OnTextChange(GtkTextBuffer*, TextEdit* edit) {
   edit->on_text_change.Emit(edit);
 }
 
+gboolean OnFlushTick(GtkWidget*, GdkFrameClock*, TextEdit* edit) {
+  edit->FlushAppendedText();
+  return G_SOURCE_REMOVE;
+}
+
+void PostFlush(TextEdit* edit) {
+  scoped_refptr<TextEdit> ref(edit);
+  MessageLoop::PostTask([ref]() { ref->FlushAppendedText(); });
+}
+
+void OnUnmap(GtkWidget*, TextEdit* edit) {
+  // The frame clock stops ticking for unmapped widgets, do not leave the
+  // appended text waiting for a pending tick.
+  PostFlush(edit);
+}
+
 }  // namespace
 
 TextEdit::TextEdit() {
@@ -32,9 +51,14 @@ TextEdit::TextEdit() {
   GtkTextBuffer* buffer = gtk_text_view_get_buffer(GTK_TEXT_VIEW(text_view));
   TextBufferMakeUndoable(buffer);
   g_signal_connect(buffer, "changed", G_CALLBACK(OnTextChange), this);
+  g_signal_connect(text_view, "unmap", G_CALLBACK(OnUnmap), this);
 }
 
 TextEdit::~TextEdit() {
+  // The widget may be unmapped when destroyed.
+  g_signal_handlers_disconnect_by_func(
+      g_object_get_data(G_OBJECT(GetNative()), "text-view"),
+      reinterpret_cast<gpointer>(OnUnmap), this);
 }
 
 void TextEdit::SetText(const std::string& text) {
@@ -76,6 +100,13 @@ bool TextEdit::CanUndo() const {
   return TextBufferCanUndo(buffer);
 }
 
+void TextEdit::SetUndoLimit(int max_actions, int max_bytes) {
+  GtkTextBuffer* buffer = gtk_text_view_get_buffer(
+      GTK_TEXT_VIEW(g_object_get_data(G_OBJECT(GetNative()), "text-view")));
+  TextBufferSetUndoLimits(buffer, std::max(max_actions, 0),
+                          std::max(max_bytes, 0));
+}
+
 void TextEdit::Cut() {
   GtkClipboard* clipboard = gtk_clipboard_get(GDK_SELECTION_CLIPBOARD);
   GtkTextBuffer* buffer = gtk_text_view_get_buffer(
@@ -162,4 +193,83 @@ void TextEdit::DeleteRange(int start, int end) {
   gtk_text_buffer_delete(buffer, &start_iter, &end_iter);
 }
 
+void TextEdit::PlatformScheduleFlush() {
+  GtkWidget* text_view =
+      GTK_WIDGET(g_object_get_data(G_OBJECT(GetNative()), "text-view"));
+  // Hidden widgets are not drawn and their frame clocks do not tick, so just
+  // flush in next loop iteration like other platforms.
+  if (!gtk_widget_get_mapped(text_view)) {
+    PostFlush(this);
+    return;
+  }
+  gtk_widget_add_tick_callback(
+      text_view, reinterpret_cast<GtkTickCallback>(OnFlushTick), this,
+      nullptr);
+}
+
+void TextEdit::PlatformAppendText(const std::string& text) {
+  GtkTextBuffer* buffer = gtk_text_view_get_buffer(
+      GTK_TEXT_VIEW(g_object_get_data(G_OBJECT(GetNative()), "text-view")));
+  GtkTextIter end_iter;
+  gtk_text_buffer_get_end_iter(buffer, &end_iter);
+  g_signal_handlers_block_by_func(
+      buffer, reinterpret_cast<gpointer>(OnTextChange), this);
+  TextBufferBeginNotUndoableAction(buffer);
+  gtk_text_buffer_insert(buffer, &end_iter, text.c_str(), text.size());
+  TextBufferEndNotUndoableAction(buffer);
+  g_signal_handlers_unblock_by_func(
+      buffer, reinterpret_cast<gpointer>(OnTextChange), this);
+}
+
+void TextEdit::PlatformDeleteLines(int count) {
+  GtkTextBuffer* buffer = gtk_text_view_get_buffer(
+      GTK_TEXT_VIEW(g_object_get_data(G_OBJECT(GetNative()), "text-view")));
+  GtkTextIter start_iter, end_iter;
+  gtk_text_buffer_get_start_iter(buffer, &start_iter);
+  gtk_text_buffer_get_iter_at_line(buffer, &end_iter, count);
+  g_signal_handlers_block_by_func(
+      buffer, reinterpret_cast<gpointer>(OnTextChange), this);
+  TextBufferBeginNotUndoableAction(buffer);
+  gtk_text_buffer_delete(buffer, &start_iter, &end_iter);
+  TextBufferEndNotUndoableAction(buffer);
+  g_signal_handlers_unblock_by_func(
+      buffer, reinterpret_cast<gpointer>(OnTextChange), this);
+  // The offsets recorded in undo actions are no longer valid.
+  TextBufferClearUndoHistory(buffer);
+}
+
+int TextEdit::PlatformGetLineCount() const {
+  GtkTextBuffer* buffer = gtk_text_view_get_buffer(
+      GTK_TEXT_VIEW(g_object_get_data(G_OBJECT(GetNative()), "text-view")));
+  int lines = gtk_text_buffer_get_line_count(buffer);
+  // Do not count the empty line after the trailing newline.
+  GtkTextIter end_iter;
+  gtk_text_buffer_get_end_iter(buffer, &end_iter);
+  if (lines > 1 && gtk_text_iter_starts_line(&end_iter))
+    --lines;
+  return lines;
+}
+
+bool TextEdit::PlatformIsScrolledToEnd() const {
+  GtkAdjustment* adjustment =
+      gtk_scrolled_window_get_vadjustment(GTK_SCROLLED_WINDOW(GetNative()));
+  return gtk_adjustment_get_value(adjustment) +
+         gtk_adjustment_get_page_size(adjustment) >=
+         gtk_adjustment_get_upper(adjustment) - 1;
+}
+
+void TextEdit::PlatformScrollToEnd() {
+  GtkTextView* text_view =
+      GTK_TEXT_VIEW(g_object_get_data(G_OBJECT(GetNative()), "text-view"));
+  GtkTextBuffer* buffer = gtk_text_view_get_buffer(text_view);
+  // A mark with right gravity always stays at the end when appending text.
+  GtkTextMark* mark = gtk_text_buffer_get_mark(buffer, "end");
+  if (!mark) {
+    GtkTextIter end_iter;
+    gtk_text_buffer_get_end_iter(buffer, &end_iter);
+    mark = gtk_text_buffer_create_mark(buffer, "end", &end_iter, FALSE);
+  }
+  gtk_text_view_scroll_mark_onscreen(text_view, mark);
+}
+
 }  // namespace nu
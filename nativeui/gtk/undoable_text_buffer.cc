@@ -6,10 +6,11 @@
 
 #include <gtk/gtk.h>
 
-#include <stack>
+#include <algorithm>
 #include <string>
 #include <utility>
 
+#include "base/containers/circular_deque.h"
 #include "base/strings/string_util.h"
 #include "nativeui/gtk/widget_util.h"
 
@@ -17,6 +18,10 @@ namespace nu {
 
 namespace {
 
+// How many of the oldest actions to look at when trying to merge actions to
+// reduce the number of entries, this keeps the compaction O(1).
+const size_t kCompactionWindow = 16;
+
 inline bool IsWhiteSpace(const std::string& text) {
   return text.length() == 1 && base::IsAsciiWhitespace(text[0]);
 }
@@ -30,22 +35,27 @@ enum ActionType {
 // An undoable action.
 struct UndoableAction {
   // Insert action.
-  UndoableAction(GtkTextIter* iter, const std::string& text)
+  UndoableAction(GtkTextIter* iter, const gchar* str, gint size)
       : type(INSERT),
         start(gtk_text_iter_get_offset(iter)),
-        text(text),
-        mergeable(!text.empty()) {
+        end(start + static_cast<int>(g_utf8_strlen(str, size))),
+        text(str, size),
+        mergeable(!text.empty()),
+        delete_key_used(false) {
   }
 
   // Delete action.
   UndoableAction(GtkTextBuffer* buffer,
                  GtkTextIter* start_iter,
                  GtkTextIter* end_iter)
-      : type(INSERT),
+      : type(DELETE),
         start(gtk_text_iter_get_offset(start_iter)),
-        end(gtk_text_iter_get_offset(end_iter)),
-        text(gtk_text_buffer_get_text(buffer, start_iter, end_iter, TRUE)),
-        mergeable(IsWhiteSpace(text)) {
+        end(gtk_text_iter_get_offset(end_iter)) {
+    // The returned string is owned by us.
+    gchar* str = gtk_text_buffer_get_text(buffer, start_iter, end_iter, TRUE);
+    text = str;
+    g_free(str);
+    mergeable = IsWhiteSpace(text);
     // Whether it is Delete or Backspace key.
     GtkTextIter insert_iter;
     gtk_text_buffer_get_iter_at_mark(buffer, &insert_iter,
@@ -53,6 +63,12 @@ struct UndoableAction {
     delete_key_used = gtk_text_iter_get_offset(&insert_iter) <= start;
   }
 
+  // Number of characters this action covers.
+  int length() const { return end - start; }
+
+  // Rough memory used by this action.
+  size_t bytes() const { return sizeof(UndoableAction) + text.capacity(); }
+
   ActionType type;
   int start;
   int end;
@@ -61,23 +77,118 @@ struct UndoableAction {
   bool delete_key_used;
 };
 
+using UndoableActions = base::circular_deque<UndoableAction>;
+
 // A structure holding the undo and redo stacks.
+//
+// The stacks are stored in ring buffers, so the oldest actions can be dropped
+// from the front cheaply when the history grows beyond the limits.
 struct UndoableData {
-  std::stack<UndoableAction> undo_stack;
-  std::stack<UndoableAction> redo_stack;
+  UndoableActions undo_stack;
+  UndoableActions redo_stack;
+  // Memory used by the actions in both stacks.
+  size_t bytes = 0;
+  // Limits of the history, 0 means unlimited.
+  size_t max_actions = 0;
+  size_t max_bytes = 0;
   bool not_undoable_action = false;
   bool undo_in_progress = true;
 };
 
+inline UndoableData* GetUndoableData(GtkTextBuffer* buffer) {
+  return static_cast<UndoableData*>(
+      g_object_get_data(G_OBJECT(buffer), "undoable-data"));
+}
+
+// Merge |next| into |prev| if they are adjacent, ignoring word boundaries.
+bool MergeAdjacentActions(UndoableAction* prev, const UndoableAction& next) {
+  if (prev->type != next.type)
+    return false;
+  if (prev->type == INSERT) {
+    if (next.start != prev->end)
+      return false;
+    prev->text += next.text;
+    prev->end = next.end;
+  } else {
+    if (prev->delete_key_used != next.delete_key_used)
+      return false;
+    if (next.start == prev->start) {  // delete key used
+      prev->text += next.text;
+      prev->end += next.length();
+    } else if (next.end == prev->start) {  // backspace key used
+      prev->text = next.text + prev->text;
+      prev->start = next.start;
+    } else {
+      return false;
+    }
+  }
+  prev->mergeable = false;
+  return true;
+}
+
+void ClearRedoStack(UndoableData* data) {
+  for (const UndoableAction& action : data->redo_stack)
+    data->bytes -= action.bytes();
+  data->redo_stack.clear();
+}
+
+void PushUndoAction(UndoableData* data, UndoableAction action) {
+  data->bytes += action.bytes();
+  data->undo_stack.push_back(std::move(action));
+}
+
+// Drop or compact the oldest actions until the history fits in the limits.
+void EnforceLimits(UndoableData* data) {
+  UndoableActions& stack = data->undo_stack;
+  // Under pressure of entries, try merging the oldest adjacent actions first,
+  // and only drop history when there is nothing to merge.
+  while (data->max_actions > 0 && stack.size() > data->max_actions) {
+    bool merged = false;
+    size_t window = std::min(stack.size() - 1, kCompactionWindow);
+    for (size_t i = 0; i < window; ++i) {
+      size_t old_bytes = stack[i].bytes() + stack[i + 1].bytes();
+      if (MergeAdjacentActions(&stack[i], stack[i + 1])) {
+        data->bytes = data->bytes - old_bytes + stack[i].bytes();
+        // Erasing from the middle would shift all the newer actions, instead
+        // shift the older ones, which are at most |kCompactionWindow|.
+        stack[i + 1] = std::move(stack[i]);
+        std::move_backward(stack.begin(), stack.begin() + i,
+                           stack.begin() + i + 1);
+        stack.pop_front();
+        merged = true;
+        break;
+      }
+    }
+    if (!merged) {
+      data->bytes -= stack.front().bytes();
+      stack.pop_front();
+    }
+  }
+  // Merging does not save the memory of texts, so just drop old history.
+  // The redo history is dropped first, starting from the farthest action,
+  // since it is discarded by the next edit anyway.
+  UndoableActions& redo_stack = data->redo_stack;
+  while (data->max_bytes > 0 && data->bytes > data->max_bytes &&
+         !redo_stack.empty()) {
+    data->bytes -= redo_stack.front().bytes();
+    redo_stack.pop_front();
+  }
+  while (data->max_bytes > 0 && data->bytes > data->max_bytes &&
+         !stack.empty()) {
+    data->bytes -= stack.front().bytes();
+    stack.pop_front();
+  }
+}
+
 void OnInsertText(GtkTextBuffer* buffer,
                   GtkTextIter* iter,
                   gchar* text, gint length,
                   UndoableData* data) {
   if (!data->undo_in_progress)
-    data->redo_stack = std::stack<UndoableAction>();
+    ClearRedoStack(data);
   if (data->not_undoable_action)
     return;
-  UndoableAction cur(iter, std::string(text, length));
+  UndoableAction cur(iter, text, length);
   // Check whether we can merge multiple inserts.
   // Will try to merge words or whitespace;
   // Can't merge if |prev| and |cur| are not mergeable in the first place;
@@ -85,17 +196,23 @@ void OnInsertText(GtkTextBuffer* buffer,
   // Can't merge across word boundaries.
   bool mergeable = false;
   if (!data->undo_stack.empty()) {
-    UndoableAction& prev = data->undo_stack.top();
+    UndoableAction& prev = data->undo_stack.back();
     mergeable =
         prev.mergeable && cur.mergeable &&
         (prev.type == cur.type) &&
-        (static_cast<size_t>(cur.start) == prev.start + prev.text.length()) &&
+        (cur.start == prev.end) &&
         (IsWhiteSpace(prev.text) != IsWhiteSpace(cur.text));
   }
-  if (mergeable)
-    data->undo_stack.top().text += cur.text;
-  else
-    data->undo_stack.push(std::move(cur));
+  if (mergeable) {
+    UndoableAction& prev = data->undo_stack.back();
+    data->bytes -= prev.bytes();
+    prev.text += cur.text;
+    prev.end = cur.end;
+    data->bytes += prev.bytes();
+  } else {
+    PushUndoAction(data, std::move(cur));
+  }
+  EnforceLimits(data);
 }
 
 void OnDeleteRange(GtkTextBuffer* buffer,
@@ -103,7 +220,7 @@ void OnDeleteRange(GtkTextBuffer* buffer,
                    GtkTextIter* end_iter,
                    UndoableData* data) {
   if (!data->undo_in_progress)
-    data->redo_stack = std::stack<UndoableAction>();
+    ClearRedoStack(data);
   if (data->not_undoable_action)
     return;
   UndoableAction cur(buffer, start_iter, end_iter);
@@ -114,7 +231,7 @@ void OnDeleteRange(GtkTextBuffer* buffer,
   // Can't merge across word boundaries.
   bool mergeable = false;
   if (!data->undo_stack.empty()) {
-    UndoableAction& prev = data->undo_stack.top();
+    UndoableAction& prev = data->undo_stack.back();
     mergeable =
         prev.mergeable && cur.mergeable &&
         (prev.type == cur.type) &&
@@ -123,17 +240,20 @@ void OnDeleteRange(GtkTextBuffer* buffer,
         (IsWhiteSpace(prev.text) != IsWhiteSpace(cur.text));
   }
   if (mergeable) {
-    UndoableAction& prev = data->undo_stack.top();
+    UndoableAction& prev = data->undo_stack.back();
+    data->bytes -= prev.bytes();
     if (prev.start == cur.start) {  // delete key used
       prev.text += cur.text;
-      prev.end += (cur.end - cur.start);
+      prev.end += cur.length();
     } else {  // backspace key used
       prev.text = cur.text + prev.text;
       prev.start = cur.start;
     }
-    return;
+    data->bytes += prev.bytes();
+  } else {
+    PushUndoAction(data, std::move(cur));
   }
-  data->undo_stack.push(std::move(cur));
+  EnforceLimits(data);
 }
 
 }  // namespace
@@ -150,20 +270,46 @@ bool TextBufferIsUndoable(GtkTextBuffer* buffer) {
   return g_object_get_data(G_OBJECT(buffer), "undoable-data");
 }
 
+void TextBufferSetUndoLimits(GtkTextBuffer* buffer,
+                             size_t max_actions,
+                             size_t max_bytes) {
+  UndoableData* data = GetUndoableData(buffer);
+  data->max_actions = max_actions;
+  data->max_bytes = max_bytes;
+  EnforceLimits(data);
+}
+
+size_t TextBufferGetUndoMemoryUsage(GtkTextBuffer* buffer) {
+  return GetUndoableData(buffer)->bytes;
+}
+
+void TextBufferBeginNotUndoableAction(GtkTextBuffer* buffer) {
+  GetUndoableData(buffer)->not_undoable_action = true;
+}
+
+void TextBufferEndNotUndoableAction(GtkTextBuffer* buffer) {
+  GetUndoableData(buffer)->not_undoable_action = false;
+}
+
+void TextBufferClearUndoHistory(GtkTextBuffer* buffer) {
+  UndoableData* data = GetUndoableData(buffer);
+  data->undo_stack.clear();
+  data->redo_stack.clear();
+  data->bytes = 0;
+}
+
 void TextBufferUndo(GtkTextBuffer* buffer) {
-  auto* data = static_cast<UndoableData*>(
-      g_object_get_data(G_OBJECT(buffer), "undoable-data"));
+  UndoableData* data = GetUndoableData(buffer);
   if (data->undo_stack.empty())
     return;
   data->not_undoable_action = true;
   data->undo_in_progress = true;
-  UndoableAction undo_action = data->undo_stack.top();
-  data->undo_stack.pop();
+  UndoableAction undo_action = std::move(data->undo_stack.back());
+  data->undo_stack.pop_back();
   if (undo_action.type == INSERT) {
     GtkTextIter start_iter, end_iter;
     gtk_text_buffer_get_iter_at_offset(buffer, &start_iter, undo_action.start);
-    gtk_text_buffer_get_iter_at_offset(
-        buffer, &end_iter, undo_action.start + undo_action.text.length());
+    gtk_text_buffer_get_iter_at_offset(buffer, &end_iter, undo_action.end);
     gtk_text_buffer_delete(buffer, &start_iter, &end_iter);
     gtk_text_buffer_place_cursor(buffer, &start_iter);
   } else {
@@ -172,6 +318,8 @@ void TextBufferUndo(GtkTextBuffer* buffer) {
     gtk_text_buffer_insert(buffer, &start_iter,
                            undo_action.text.data(), undo_action.text.length());
     if (undo_action.delete_key_used) {
+      gtk_text_buffer_get_iter_at_offset(buffer, &start_iter,
+                                         undo_action.start);
       gtk_text_buffer_place_cursor(buffer, &start_iter);
     } else {
       GtkTextIter end_iter;
@@ -179,33 +327,29 @@ void TextBufferUndo(GtkTextBuffer* buffer) {
       gtk_text_buffer_place_cursor(buffer, &end_iter);
     }
   }
-  data->redo_stack.push(std::move(undo_action));
+  data->redo_stack.push_back(std::move(undo_action));
   data->not_undoable_action = false;
   data->undo_in_progress = false;
 }
 
 bool TextBufferCanUndo(GtkTextBuffer* buffer) {
-  auto* data = static_cast<UndoableData*>(
-      g_object_get_data(G_OBJECT(buffer), "undoable-data"));
-  return !data->undo_stack.empty();
+  return !GetUndoableData(buffer)->undo_stack.empty();
 }
 
 void TextBufferRedo(GtkTextBuffer* buffer) {
-  auto* data = static_cast<UndoableData*>(
-      g_object_get_data(G_OBJECT(buffer), "undoable-data"));
+  UndoableData* data = GetUndoableData(buffer);
   if (data->redo_stack.empty())
     return;
   data->not_undoable_action = true;
   data->undo_in_progress = true;
-  UndoableAction redo_action = data->redo_stack.top();
-  data->redo_stack.pop();
+  UndoableAction redo_action = std::move(data->redo_stack.back());
+  data->redo_stack.pop_back();
   if (redo_action.type == INSERT) {
     GtkTextIter start_iter, end_iter;
     gtk_text_buffer_get_iter_at_offset(buffer, &start_iter, redo_action.start);
     gtk_text_buffer_insert(buffer, &start_iter,
                            redo_action.text.data(), redo_action.text.length());
-    gtk_text_buffer_get_iter_at_offset(
-        buffer, &end_iter, redo_action.start + redo_action.text.length());
+    gtk_text_buffer_get_iter_at_offset(buffer, &end_iter, redo_action.end);
     gtk_text_buffer_place_cursor(buffer, &end_iter);
   } else {
     GtkTextIter start_iter, end_iter;
@@ -214,15 +358,13 @@ void TextBufferRedo(GtkTextBuffer* buffer) {
     gtk_text_buffer_delete(buffer, &start_iter, &end_iter);
     gtk_text_buffer_place_cursor(buffer, &start_iter);
   }
-  data->undo_stack.push(std::move(redo_action));
+  data->undo_stack.push_back(std::move(redo_action));
   data->not_undoable_action = false;
   data->undo_in_progress = false;
 }
 
 bool TextBufferCanRedo(GtkTextBuffer* buffer) {
-  auto* data = static_cast<UndoableData*>(
-      g_object_get_data(G_OBJECT(buffer), "undoable-data"));
-  return !data->redo_stack.empty();
+  return !GetUndoableData(buffer)->redo_stack.empty();
 }
 
 }  // namespace nu
@@ -5,6 +5,10 @@
 #ifndef NATIVEUI_GTK_UNDOABLE_TEXT_BUFFER_H_
 #define NATIVEUI_GTK_UNDOABLE_TEXT_BUFFER_H_
 
+#include <stddef.h>
+
+#include "nativeui/nativeui_export.h"
+
 typedef struct _GtkTextBuffer GtkTextBuffer;
 
 namespace nu {
@@ -13,6 +17,22 @@ namespace nu {
 void TextBufferMakeUndoable(GtkTextBuffer* buffer);
 bool TextBufferIsUndoable(GtkTextBuffer* buffer);
 
+// Limit the number of actions and the memory kept in history, old actions
+// would be merged or dropped when exceeding the limits. 0 means unlimited.
+void TextBufferSetUndoLimits(GtkTextBuffer* buffer,
+                             size_t max_actions,
+                             size_t max_bytes);
+
+// Return the memory used by the undo/redo stacks.
+NATIVEUI_EXPORT size_t TextBufferGetUndoMemoryUsage(GtkTextBuffer* buffer);
+
+// Changes made between these calls are not recorded.
+void TextBufferBeginNotUndoableAction(GtkTextBuffer* buffer);
+void TextBufferEndNotUndoableAction(GtkTextBuffer* buffer);
+
+// Forget all the actions, used when the recorded offsets become invalid.
+void TextBufferClearUndoHistory(GtkTextBuffer* buffer);
+
 // Manipulate the undo/redo stacks.
 void TextBufferUndo(GtkTextBuffer* buffer);
 bool TextBufferCanUndo(GtkTextBuffer* buffer);
@@ -5,8 +5,13 @@
 #include "nativeui/gtk/widget_util.h"
 
 #include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
+#include "base/lazy_instance.h"
 #include "base/logging.h"
+#include "build/build_config.h"
 #include "nativeui/gfx/color.h"
 
 #ifdef GDK_WINDOWING_X11
@@ -14,6 +19,10 @@
 #include <X11/Xatom.h>  // XA_CARDINAL
 #endif
 
+#if defined(ARCH_CPU_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+
 namespace nu {
 
 namespace {
@@ -31,6 +40,84 @@ bool CairoSurfaceExtents(cairo_surface_t* surface, GdkRectangle* extents) {
   return true;
 }
 
+// Return the first position from |x| where the transparency of pixel equals
+// to |transparent|, or |width| if there is no such pixel.
+int FindPixel(const uint8_t* data, int x, int width, bool transparent) {
+#if defined(ARCH_CPU_X86_FAMILY)
+  // Skip 16 pixels at once when none of them matches.
+  const __m128i zero = _mm_setzero_si128();
+  const int skip_mask = transparent ? 0 : 0xFFFF;
+  for (; x + 16 <= width; x += 16) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + x));
+    int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, zero));
+    if (mask != skip_mask)
+      return x + __builtin_ctz(transparent ? mask : ~mask);
+  }
+#endif
+  for (; x < width; ++x) {
+    if ((data[x] == 0) == transparent)
+      break;
+  }
+  return x;
+}
+
+// Append the runs of non-transparent pixels in the row as rectangles.
+void ScanOpaqueRuns(const uint8_t* data, int width, int y,
+                    std::vector<cairo_rectangle_int_t>* runs) {
+  int x = 0;
+  while (x < width) {
+    // Only full-transparent pixels are treated as transparent, this is
+    // to match the behavior of macOS and Win32.
+    int start = FindPixel(data, x, width, false);
+    if (start == width)
+      break;
+    x = FindPixel(data, start, width, true);
+    runs->push_back({start, y, x - start, 1});
+  }
+}
+
+// Whether the rectangles cover the same columns.
+bool IsSameRuns(const std::vector<cairo_rectangle_int_t>& a,
+                const std::vector<cairo_rectangle_int_t>& b) {
+  if (a.size() != b.size())
+    return false;
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (a[i].x != b[i].x || a[i].width != b[i].width)
+      return false;
+  }
+  return true;
+}
+
+// Providers shared by widgets using the same CSS. The map does not own the
+// providers, and an entry is removed when its provider is destroyed.
+using ProviderMap = std::unordered_map<std::string, GtkCssProvider*>;
+
+base::LazyInstance<ProviderMap>::Leaky g_providers = LAZY_INSTANCE_INITIALIZER;
+
+void OnProviderDestroyed(gpointer data, GObject* provider) {
+  std::string* style = static_cast<std::string*>(data);
+  g_providers.Get().erase(*style);
+  delete style;
+}
+
+// Return a new reference to the provider loaded with |style|, the CSS is only
+// parsed when no widget is using the same style.
+GtkCssProvider* GetSharedProvider(base::StringPiece style) {
+  ProviderMap& providers = g_providers.Get();
+  std::string key = style.as_string();
+  auto it = providers.find(key);
+  if (it != providers.end())
+    return GTK_CSS_PROVIDER(g_object_ref(it->second));
+
+  GtkCssProvider* provider = gtk_css_provider_new();
+  gtk_css_provider_load_from_data(
+      provider, style.data(), style.length(), nullptr);
+  g_object_weak_ref(G_OBJECT(provider), OnProviderDestroyed,
+                    new std::string(key));
+  providers[key] = provider;
+  return provider;
+}
+
 }  // namespace
 
 SizeF GetPreferredSizeForWidget(GtkWidget* widget) {
@@ -63,35 +150,33 @@ cairo_region_t* CreateRegionFromSurface(cairo_surface_t* surface) {
     cairo_surface_flush(image);
   }
 
-  cairo_region_t* region = cairo_region_create();
-
-  // Iterate through the image.
-  uint8_t* data = cairo_image_surface_get_data(image);
+  const uint8_t* data = cairo_image_surface_get_data(image);
   int stride = cairo_image_surface_get_stride(image);
 
-  for (int y = 0; y < extents.height; y++) {
-    for (int x = 0; x < extents.width; x++) {
-      // Find a row with all transparent pixels.
-      int ps = x;
-      while (x < extents.width) {
-        // Only full-transparent pixels are treated as transparent, this is
-        // to match the behavior of macOS and Win32.
-        if (data[x] == 0)
-          break;
-        x++;
-      }
-
-      if (x > ps) {
-        // Add the row to region.
-        GdkRectangle rect = {ps, y, x - ps, 1};
-        cairo_region_union_rectangle(region, &rect);
-      }
+  // Consecutive rows with the same runs are merged into taller rectangles,
+  // which are kept in |open| until a different row is met.
+  std::vector<cairo_rectangle_int_t> rects;
+  std::vector<cairo_rectangle_int_t> open;
+  std::vector<cairo_rectangle_int_t> row;
+  for (int y = 0; y < extents.height; ++y) {
+    row.clear();
+    ScanOpaqueRuns(data, extents.width, y, &row);
+    if (IsSameRuns(open, row)) {
+      for (cairo_rectangle_int_t& rect : open)
+        rect.height++;
+    } else {
+      rects.insert(rects.end(), open.begin(), open.end());
+      open.swap(row);
     }
-
     data += stride;
   }
-
+  rects.insert(rects.end(), open.begin(), open.end());
   cairo_surface_destroy(image);
+
+  // Creating the region in one call is much faster than adding rectangles one
+  // by one, which has to merge the region each time.
+  cairo_region_t* region = cairo_region_create_rectangles(
+      rects.data(), static_cast<int>(rects.size()));
   cairo_region_translate(region, extents.x, extents.y);
   return region;
 }
@@ -99,15 +184,17 @@ cairo_region_t* CreateRegionFromSurface(cairo_surface_t* surface) {
 void ApplyStyle(GtkWidget* widget,
                 base::StringPiece name,
                 base::StringPiece style) {
+  GtkCssProvider* provider = GetSharedProvider(style);
   void* old = g_object_get_data(G_OBJECT(widget), name.data());
+  if (old == provider) {
+    g_object_unref(provider);
+    return;
+  }
+
   if (old)
     gtk_style_context_remove_provider(
         gtk_widget_get_style_context(widget),
         GTK_STYLE_PROVIDER(old));
-
-  GtkCssProvider* provider = gtk_css_provider_new();
-  gtk_css_provider_load_from_data(
-      provider, style.data(), style.length(), nullptr);
   gtk_style_context_add_provider(
       gtk_widget_get_style_context(widget),
       GTK_STYLE_PROVIDER(provider), G_MAXUINT);
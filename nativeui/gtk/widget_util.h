@@ -10,6 +10,7 @@
 #include "base/strings/string_piece.h"
 #include "nativeui/gfx/geometry/insets_f.h"
 #include "nativeui/gfx/geometry/size_f.h"
+#include "nativeui/nativeui_export.h"
 #include "nativeui/types.h"
 
 typedef struct _cairo_region cairo_region_t;
@@ -20,10 +21,11 @@ SizeF GetPreferredSizeForWidget(NativeView widget);
 
 // Like gdk_cairo_region_create_from_surface, but also include semi-transparent
 // points into the region.
-cairo_region_t* CreateRegionFromSurface(cairo_surface_t* surface);
+NATIVEUI_EXPORT cairo_region_t* CreateRegionFromSurface(
+    cairo_surface_t* surface);
 
 // Apply CSS |style| on |widget|, the style with same |name| will be
-// overwritten.
+// overwritten. Widgets with the same |style| share one provider.
 void ApplyStyle(GtkWidget* widget,
                 base::StringPiece name,
                 base::StringPiece style);
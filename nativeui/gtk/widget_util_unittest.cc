@@ -0,0 +1,103 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "nativeui/gtk/widget_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// Width that is not a multiple of 16, so the scalar tail is used.
+const int kWidth = 53;
+const int kHeight = 24;
+
+// Set alpha of the pixels in [start, end) of row |y|.
+void FillRun(uint8_t* data, int stride, int y, int start, int end,
+             uint8_t alpha) {
+  for (int x = start; x < end; ++x)
+    data[y * stride + x] = alpha;
+}
+
+// Fill the A8 |data| with runs that cross 16-pixel boundaries, groups of
+// identical rows, an empty row and random rows.
+void FillAlpha(uint8_t* data, int stride) {
+  for (int y = 0; y < 5; ++y) {
+    FillRun(data, stride, y, 3, 17, 255);
+    FillRun(data, stride, y, 30, 48, 1);
+    FillRun(data, stride, y, 50, kWidth, 128);
+  }
+  for (int y = 5; y < 10; ++y) {
+    FillRun(data, stride, y, 0, 16, 255);
+    FillRun(data, stride, y, 16, 32, 0);
+    FillRun(data, stride, y, 32, 33, 255);
+  }
+  // Row 10 is empty, and row 11 is full.
+  FillRun(data, stride, 11, 0, kWidth, 255);
+  srand(1);
+  for (int y = 12; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x)
+      data[y * stride + x] = (rand() % 3 == 0) ? (rand() & 0xFF) : 0;
+  }
+}
+
+// The plain implementation that adds each non-transparent pixel.
+cairo_region_t* CreateRegionPerPixel(const uint8_t* data, int stride) {
+  cairo_region_t* region = cairo_region_create();
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      if (data[y * stride + x] != 0) {
+        cairo_rectangle_int_t rect = {x, y, 1, 1};
+        cairo_region_union_rectangle(region, &rect);
+      }
+    }
+  }
+  return region;
+}
+
+}  // namespace
+
+TEST(WidgetUtilTest, CreateRegionFromA8Surface) {
+  cairo_surface_t* surface =
+      cairo_image_surface_create(CAIRO_FORMAT_A8, kWidth, kHeight);
+  uint8_t* data = cairo_image_surface_get_data(surface);
+  int stride = cairo_image_surface_get_stride(surface);
+  FillAlpha(data, stride);
+  cairo_surface_mark_dirty(surface);
+
+  cairo_region_t* expected = CreateRegionPerPixel(data, stride);
+  cairo_region_t* region = nu::CreateRegionFromSurface(surface);
+  EXPECT_TRUE(cairo_region_equal(region, expected));
+  cairo_region_destroy(region);
+  cairo_region_destroy(expected);
+  cairo_surface_destroy(surface);
+}
+
+TEST(WidgetUtilTest, CreateRegionFromARGBSurface) {
+  // Build the alpha in an A8 buffer and put it into premultiplied pixels.
+  int a8_stride = cairo_format_stride_for_width(CAIRO_FORMAT_A8, kWidth);
+  uint8_t* alpha = static_cast<uint8_t*>(calloc(a8_stride * kHeight, 1));
+  FillAlpha(alpha, a8_stride);
+  cairo_surface_t* surface =
+      cairo_image_surface_create(CAIRO_FORMAT_ARGB32, kWidth, kHeight);
+  uint8_t* data = cairo_image_surface_get_data(surface);
+  int stride = cairo_image_surface_get_stride(surface);
+  for (int y = 0; y < kHeight; ++y) {
+    uint32_t* row = reinterpret_cast<uint32_t*>(data + y * stride);
+    for (int x = 0; x < kWidth; ++x) {
+      uint32_t a = alpha[y * a8_stride + x];
+      row[x] = (a << 24) | (a << 16);
+    }
+  }
+  cairo_surface_mark_dirty(surface);
+
+  cairo_region_t* expected = CreateRegionPerPixel(alpha, a8_stride);
+  cairo_region_t* region = nu::CreateRegionFromSurface(surface);
+  EXPECT_TRUE(cairo_region_equal(region, expected));
+  cairo_region_destroy(region);
+  cairo_region_destroy(expected);
+  cairo_surface_destroy(surface);
+  free(alpha);
+}
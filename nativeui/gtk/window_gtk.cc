@@ -31,6 +31,12 @@ struct NUWindowPrivate {
   bool is_input_shape_set = false;
   bool is_draw_handler_set = false;
   guint draw_handler_id = 0;
+  // The input shape is only computed again when the size of window or the
+  // generation of content changes.
+  int input_shape_generation = 0;
+  int input_shape_applied_generation = 0;
+  int input_shape_width = 0;
+  int input_shape_height = 0;
 };
 
 // Helper to receive private data.
@@ -81,14 +87,29 @@ void OnScreenChanged(GtkWidget* widget, GdkScreen* old_screen, Window* window) {
 
 // Set input shape for frameless transparent window.
 gboolean OnDraw(GtkWidget* widget, cairo_t* cr, NUWindowPrivate* priv) {
+  GdkWindow* gdkwindow = gtk_widget_get_window(widget);
+  int width = gdk_window_get_width(gdkwindow);
+  int height = gdk_window_get_height(gdkwindow);
+  if (priv->is_input_shape_set &&
+      priv->input_shape_applied_generation == priv->input_shape_generation &&
+      priv->input_shape_width == width &&
+      priv->input_shape_height == height)
+    return FALSE;
+  // Partial redraws do not have the full content of window, wait for a full
+  // one, which always happens after resizing.
+  GdkRectangle clip;
+  if (!gdk_cairo_get_clip_rectangle(cr, &clip) ||
+      clip.x > 0 || clip.y > 0 ||
+      clip.x + clip.width < width || clip.y + clip.height < height)
+    return FALSE;
   cairo_surface_t* surface = cairo_get_target(cr);
   cairo_region_t* region = CreateRegionFromSurface(surface);
   gtk_widget_input_shape_combine_region(widget, region);
   cairo_region_destroy(region);
-  // Only handle once.
-  priv->is_draw_handler_set = false;
   priv->is_input_shape_set = true;
-  g_signal_handler_disconnect(widget, priv->draw_handler_id);
+  priv->input_shape_applied_generation = priv->input_shape_generation;
+  priv->input_shape_width = width;
+  priv->input_shape_height = height;
   return FALSE;
 }
 
@@ -176,11 +197,12 @@ void Window::PlatformSetContentView(View* view) {
   ForceSizeAllocation(window_, GTK_WIDGET(vbox));
 
   // For frameless transparent window, we need to set input shape to allow
-  // click-through in transparent areas. For best performance we only set
-  // input shape the first time when content view is drawn, GTK do redraws very
-  // frequently and computing input shape is rather expensive.
+  // click-through in transparent areas. For best performance we only compute
+  // input shape when content view is changed or window is resized, GTK do
+  // redraws very frequently and computing input shape is rather expensive.
   if (IsTransparent() && !HasFrame()) {
     NUWindowPrivate* priv = GetPrivate(this);
+    priv->input_shape_generation++;
     if (!priv->is_draw_handler_set) {
       priv->is_draw_handler_set = true;
       priv->draw_handler_id = g_signal_connect_after(
@@ -5,9 +5,84 @@
 #include "nativeui/message_loop.h"
 
 #import <Cocoa/Cocoa.h>
+#import <CoreVideo/CoreVideo.h>
+
+#include <atomic>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/lazy_instance.h"
+#include "base/synchronization/lock.h"
+#include "nativeui/window.h"
 
 namespace nu {
 
+namespace {
+
+// The delayed tasks are implemented with dispatch timers, which can be
+// cancelled and restarted.
+struct DelayedTask {
+  dispatch_source_t timer;
+  int ms;
+};
+
+struct DelayedTasks {
+  base::Lock lock;
+  MessageLoop::TimerId next_id = 1;
+  std::unordered_map<MessageLoop::TimerId, DelayedTask> tasks;
+};
+
+base::LazyInstance<DelayedTasks>::Leaky g_delayed_tasks =
+    LAZY_INSTANCE_INITIALIZER;
+
+void StartTimer(dispatch_source_t timer, int ms) {
+  dispatch_source_set_timer(timer,
+                            dispatch_time(DISPATCH_TIME_NOW,
+                                          ms * NSEC_PER_MSEC),
+                            DISPATCH_TIME_FOREVER, 0);
+}
+
+// Frame callbacks are batched globally and driven by one display link.
+base::LazyInstance<std::vector<MessageLoop::FrameCallback>>::Leaky
+    g_frame_callbacks = LAZY_INSTANCE_INITIALIZER;
+CVDisplayLinkRef g_display_link = nullptr;
+
+// Whether a frame has been sent to main thread but not run yet.
+std::atomic<bool> g_frame_pending(false);
+
+void RunFrameCallbacks(double frame_time) {
+  g_frame_pending = false;
+  std::vector<MessageLoop::FrameCallback> callbacks;
+  callbacks.swap(g_frame_callbacks.Get());
+  // Stop the display link when nobody is requesting frames.
+  if (callbacks.empty()) {
+    CVDisplayLinkStop(g_display_link);
+    return;
+  }
+  for (const auto& callback : callbacks)
+    callback(frame_time);
+}
+
+CVReturn OnDisplayLink(CVDisplayLinkRef display_link,
+                       const CVTimeStamp* now,
+                       const CVTimeStamp* output_time,
+                       CVOptionFlags flags_in,
+                       CVOptionFlags* flags_out,
+                       void* context) {
+  // Skip the frame if main thread is still busy with last one.
+  if (g_frame_pending.exchange(true))
+    return kCVReturnSuccess;
+  double frame_time = static_cast<double>(output_time->hostTime) * 1000. /
+                      CVGetHostClockFrequency();
+  dispatch_async(dispatch_get_main_queue(), ^{
+    RunFrameCallbacks(frame_time);
+  });
+  return kCVReturnSuccess;
+}
+
+}  // namespace
+
 // static
 void MessageLoop::Run() {
   [NSApp run];
@@ -30,20 +105,87 @@ void MessageLoop::Quit() {
 }
 
 // static
-void MessageLoop::PostTask(const std::function<void()>& task) {
-  __block auto callback = task;
+void MessageLoop::PostTask(Task task) {
+  __block Task callback = std::move(task);
   dispatch_async(dispatch_get_main_queue(), ^{
     callback();
   });
 }
 
 // static
-void MessageLoop::PostDelayedTask(int ms, const std::function<void()>& task) {
-  __block std::function<void()> callback = task;
-  dispatch_time_t t = dispatch_time(DISPATCH_TIME_NOW, ms * NSEC_PER_MSEC);
-  dispatch_after(t, dispatch_get_main_queue(), ^{
+MessageLoop::TimerId MessageLoop::PostDelayedTask(int ms, Task task) {
+  DelayedTasks& delayed = g_delayed_tasks.Get();
+  dispatch_source_t timer = dispatch_source_create(
+      DISPATCH_SOURCE_TYPE_TIMER, 0, 0, dispatch_get_main_queue());
+  TimerId id;
+  {
+    base::AutoLock auto_lock(delayed.lock);
+    id = delayed.next_id++;
+    if (delayed.next_id <= 0)
+      delayed.next_id = 1;
+    delayed.tasks[id] = {timer, ms};
+  }
+  __block Task callback = std::move(task);
+  dispatch_source_set_event_handler(timer, ^{
+    {
+      DelayedTasks& delayed = g_delayed_tasks.Get();
+      base::AutoLock auto_lock(delayed.lock);
+      // The task might have been cancelled after the event got queued.
+      if (delayed.tasks.erase(id) == 0)
+        return;
+    }
+    dispatch_source_cancel(timer);
+    dispatch_release(timer);
     callback();
   });
+  StartTimer(timer, ms);
+  dispatch_resume(timer);
+  return id;
+}
+
+// static
+void MessageLoop::CancelDelayedTask(TimerId id) {
+  DelayedTasks& delayed = g_delayed_tasks.Get();
+  dispatch_source_t timer;
+  {
+    base::AutoLock auto_lock(delayed.lock);
+    auto it = delayed.tasks.find(id);
+    if (it == delayed.tasks.end())
+      return;
+    timer = it->second.timer;
+    delayed.tasks.erase(it);
+  }
+  dispatch_source_cancel(timer);
+  dispatch_release(timer);
+}
+
+// static
+void MessageLoop::ResetDelayedTask(TimerId id) {
+  DelayedTasks& delayed = g_delayed_tasks.Get();
+  base::AutoLock auto_lock(delayed.lock);
+  auto it = delayed.tasks.find(id);
+  if (it != delayed.tasks.end())
+    StartTimer(it->second.timer, it->second.ms);
+}
+
+// static
+void MessageLoop::RequestFrame(Window* window, FrameCallback callback) {
+  g_frame_callbacks.Get().push_back(std::move(callback));
+  if (!g_display_link) {
+    CVDisplayLinkCreateWithActiveCGDisplays(&g_display_link);
+    CVDisplayLinkSetOutputCallback(g_display_link, &OnDisplayLink, nullptr);
+  }
+  if (CVDisplayLinkIsRunning(g_display_link))
+    return;
+  // Follow the refresh rate of the screen that the window is on.
+  NSScreen* screen = [window->GetNative() screen];
+  if (screen) {
+    NSNumber* display_id = [[screen deviceDescription]
+        objectForKey:@"NSScreenNumber"];
+    CVDisplayLinkSetCurrentCGDisplay(g_display_link,
+                                     [display_id unsignedIntValue]);
+  }
+  CVDisplayLinkStart(g_display_link);
 }
 
 }  // namespace nu
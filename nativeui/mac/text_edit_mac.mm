@@ -4,9 +4,12 @@
 
 #include "nativeui/text_edit.h"
 
+#include <algorithm>
+
 #include "base/mac/scoped_nsobject.h"
 #include "base/strings/sys_string_conversions.h"
 #include "nativeui/gfx/font.h"
+#include "nativeui/message_loop.h"
 #include "nativeui/mac/nu_private.h"
 #include "nativeui/mac/nu_view.h"
 
@@ -36,8 +39,14 @@
   base::scoped_nsobject<NSTextView> textView_;
   base::scoped_nsobject<NUTextViewDelegate> delegate_;
   nu::NUPrivate private_;
+  // Number of lines in the storage, -1 if the text was changed by others.
+  int lineCount_;
+  BOOL trackingLines_;
 }
 - (id)initWithShell:(nu::TextEdit*)shell;
+- (void)appendText:(NSAttributedString*)text;
+- (void)deleteLines:(int)count;
+- (int)lineCount;
 - (nu::NUPrivate*)nuPrivate;
 - (void)setNUFont:(nu::Font*)font;
 - (void)setNUColor:(nu::Color)color;
@@ -59,10 +68,76 @@
     [[textView_ textContainer] setContainerSize:NSMakeSize(FLT_MAX, FLT_MAX)];
     [[textView_ textContainer] setWidthTracksTextView:YES];
     self.documentView = textView_.get();
+    lineCount_ = 0;
+    trackingLines_ = NO;
+    [[NSNotificationCenter defaultCenter]
+        addObserver:self
+           selector:@selector(textStorageDidProcessEditing:)
+               name:NSTextStorageDidProcessEditingNotification
+             object:[textView_ textStorage]];
   }
   return self;
 }
 
+- (void)dealloc {
+  [[NSNotificationCenter defaultCenter] removeObserver:self];
+  [super dealloc];
+}
+
+- (void)textStorageDidProcessEditing:(NSNotification*)notification {
+  if (!trackingLines_)
+    lineCount_ = -1;
+}
+
+- (void)appendText:(NSAttributedString*)text {
+  NSTextStorage* storage = [textView_ textStorage];
+  NSUInteger start = [storage length];
+  trackingLines_ = YES;
+  [storage appendAttributedString:text];
+  trackingLines_ = NO;
+  if (lineCount_ < 0)
+    return;
+  // Count again from the old last line, which may now be continued.
+  NSString* str = [storage string];
+  if (start > 0) {
+    start = [str lineRangeForRange:NSMakeRange(start - 1, 0)].location;
+    --lineCount_;
+  }
+  while (start < [str length]) {
+    start = NSMaxRange([str lineRangeForRange:NSMakeRange(start, 0)]);
+    ++lineCount_;
+  }
+}
+
+- (void)deleteLines:(int)count {
+  NSTextStorage* storage = [textView_ textStorage];
+  NSString* str = [storage string];
+  NSUInteger end = 0;
+  int deleted = 0;
+  for (; deleted < count && end < [str length]; ++deleted)
+    end = NSMaxRange([str lineRangeForRange:NSMakeRange(end, 0)]);
+  trackingLines_ = YES;
+  [storage deleteCharactersInRange:NSMakeRange(0, end)];
+  trackingLines_ = NO;
+  if (lineCount_ >= 0)
+    lineCount_ -= deleted;
+  // The ranges recorded in undo actions are no longer valid.
+  [[textView_ undoManager] removeAllActions];
+}
+
+- (int)lineCount {
+  if (lineCount_ < 0) {
+    NSString* str = [[textView_ textStorage] string];
+    lineCount_ = 0;
+    NSUInteger index = 0;
+    while (index < [str length]) {
+      index = NSMaxRange([str lineRangeForRange:NSMakeRange(index, 0)]);
+      ++lineCount_;
+    }
+  }
+  return lineCount_;
+}
+
 - (nu::NUPrivate*)nuPrivate {
   return &private_;
 }
@@ -130,6 +205,13 @@ bool TextEdit::CanUndo() const {
   return [[text_view undoManager] canUndo];
 }
 
+void TextEdit::SetUndoLimit(int max_actions, int max_bytes) {
+  // NSUndoManager can only limit the number of actions.
+  auto* text_view = static_cast<NSTextView*>(
+      [static_cast<NUTextEdit*>(GetNative()) documentView]);
+  [[text_view undoManager] setLevelsOfUndo:std::max(max_actions, 0)];
+}
+
 void TextEdit::Cut() {
   auto* text_view = static_cast<NSTextView*>(
       [static_cast<NUTextEdit*>(GetNative()) documentView]);
@@ -206,4 +288,40 @@ void TextEdit::DeleteRange(int start, int end) {
        replacementRange:NSMakeRange(start, end - start)];
 }
 
+void TextEdit::PlatformScheduleFlush() {
+  scoped_refptr<TextEdit> ref(this);
+  MessageLoop::PostTask([ref]() { ref->FlushAppendedText(); });
+}
+
+void TextEdit::PlatformAppendText(const std::string& text) {
+  auto* edit = static_cast<NUTextEdit*>(GetNative());
+  // Modifying the storage directly does not go through undo manager.
+  base::scoped_nsobject<NSAttributedString> str([[NSAttributedString alloc]
+      initWithString:base::SysUTF8ToNSString(text)
+          attributes:[[edit documentView] typingAttributes]]);
+  [edit appendText:str.get()];
+}
+
+void TextEdit::PlatformDeleteLines(int count) {
+  [static_cast<NUTextEdit*>(GetNative()) deleteLines:count];
+}
+
+int TextEdit::PlatformGetLineCount() const {
+  // The count is updated with appended and deleted lines instead of scanning
+  // the whole text on every flush.
+  return [static_cast<NUTextEdit*>(GetNative()) lineCount];
+}
+
+bool TextEdit::PlatformIsScrolledToEnd() const {
+  auto* scroll = static_cast<NUTextEdit*>(GetNative());
+  NSRect visible = [[scroll contentView] documentVisibleRect];
+  return NSMaxY(visible) >= NSMaxY([[scroll documentView] bounds]) - 1;
+}
+
+void TextEdit::PlatformScrollToEnd() {
+  auto* text_view = static_cast<NSTextView*>(
+      [static_cast<NUTextEdit*>(GetNative()) documentView]);
+  [text_view scrollRangeToVisible:NSMakeRange([[text_view string] length], 0)];
+}
+
 }  // namespace nu
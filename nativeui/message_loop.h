@@ -5,6 +5,7 @@
 #ifndef NATIVEUI_MESSAGE_LOOP_H_
 #define NATIVEUI_MESSAGE_LOOP_H_
 
+#include <functional>
 #include <unordered_map>
 
 #include "base/synchronization/lock.h"
@@ -12,24 +13,55 @@
 
 namespace nu {
 
+class Window;
+
 // Communicate with the GUI message loop. All methods are thread-safe.
 class NATIVEUI_EXPORT MessageLoop {
  public:
   // Function type for tasks.
   using Task = std::function<void()>;
 
+  // Function type for frame callbacks, receives the frame time in ms.
+  using FrameCallback = std::function<void(double)>;
+
+  // Identifies a delayed task, never 0.
+  using TimerId = int;
+
   // Control message loop.
   static void Run();
   static void Quit();
-  static void PostTask(const Task& task);
-  static void PostDelayedTask(int ms, const Task& task);
+  static void PostTask(Task task);
+  static TimerId PostDelayedTask(int ms, Task task);
+
+  // Cancel the delayed task, nothing happens if it has already run.
+  static void CancelDelayedTask(TimerId id);
+  // Restart the countdown of the delayed task with its original delay.
+  static void ResetDelayedTask(TimerId id);
+
+  // Run |callback| before |window| paints next frame, callbacks requested for
+  // the same frame run together with the same frame time. Unlike other
+  // methods this must be called on the GUI thread.
+  static void RequestFrame(Window* window, FrameCallback callback);
 
  private:
 #if defined(OS_WIN)
-  static void CALLBACK OnTimer(HWND, UINT, UINT_PTR event, DWORD);
+  friend class State;
+
+  // Called by State on the GUI thread.
+  static void CreateTaskWindow();
+
+  struct DelayedTask {
+    int ms;
+    Task task;
+  };
+
+  static LRESULT CALLBACK TaskWindowProc(HWND hwnd, UINT message,
+                                         WPARAM w_param, LPARAM l_param);
+  static void OnTimer(TimerId id);
 
   static base::Lock lock_;
-  static std::unordered_map<UINT_PTR, Task> tasks_;
+  static TimerId next_id_;
+  static std::unordered_map<TimerId, DelayedTask> tasks_;
 #endif
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(MessageLoop);
@@ -2,6 +2,9 @@
 // Use of this source code is governed by the license that can be found in the
 // LICENSE file.
 
+#include <thread>  // NOLINT
+#include <vector>
+
 #include "nativeui/nativeui.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -20,3 +23,90 @@ TEST_F(MessageLoopTest, PostTask) {
   });
   nu::MessageLoop::Run();
 }
+
+TEST_F(MessageLoopTest, PostTaskOrder) {
+  std::vector<int> order;
+  for (int i = 0; i < 1000; ++i)
+    nu::MessageLoop::PostTask([&order, i]() { order.push_back(i); });
+  nu::MessageLoop::PostTask([]() {
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+  ASSERT_EQ(order.size(), 1000u);
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(order[i], i);
+}
+
+TEST_F(MessageLoopTest, PostTaskFromThreads) {
+  const int kThreads = 4;
+  const int kTasksPerThread = 10000;
+  int count = 0;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&count]() {
+      for (int j = 0; j < kTasksPerThread; ++j) {
+        nu::MessageLoop::PostTask([&count]() {
+          if (++count == kThreads * kTasksPerThread)
+            nu::MessageLoop::Quit();
+        });
+      }
+    });
+  }
+  nu::MessageLoop::Run();
+  for (std::thread& thread : threads)
+    thread.join();
+  EXPECT_EQ(count, kThreads * kTasksPerThread);
+}
+
+TEST_F(MessageLoopTest, RequestFrame) {
+  scoped_refptr<nu::Window> window(new nu::Window(nu::Window::Options()));
+  window->SetVisible(true);
+  std::vector<double> times;
+  nu::MessageLoop::RequestFrame(window.get(), [&](double time) {
+    times.push_back(time);
+  });
+  nu::MessageLoop::RequestFrame(window.get(), [&](double time) {
+    times.push_back(time);
+    // Requested in a frame callback, runs in next frame.
+    nu::MessageLoop::RequestFrame(window.get(), [&](double time) {
+      times.push_back(time);
+      nu::MessageLoop::Quit();
+    });
+  });
+  nu::MessageLoop::Run();
+  ASSERT_EQ(times.size(), 3u);
+  EXPECT_EQ(times[0], times[1]);
+  EXPECT_GT(times[2], times[1]);
+}
+
+TEST_F(MessageLoopTest, CancelDelayedTask) {
+  bool cancelled_run = false;
+  nu::MessageLoop::TimerId id = nu::MessageLoop::PostDelayedTask(10, [&]() {
+    cancelled_run = true;
+  });
+  EXPECT_NE(id, 0);
+  nu::MessageLoop::CancelDelayedTask(id);
+  nu::MessageLoop::PostDelayedTask(50, []() {
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+  EXPECT_FALSE(cancelled_run);
+}
+
+TEST_F(MessageLoopTest, ResetDelayedTask) {
+  int order = 0;
+  int reset_order = 0;
+  nu::MessageLoop::TimerId id = nu::MessageLoop::PostDelayedTask(50, [&]() {
+    reset_order = ++order;
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::PostDelayedTask(30, [&]() {
+    nu::MessageLoop::ResetDelayedTask(id);
+  });
+  nu::MessageLoop::PostDelayedTask(60, [&]() {
+    ++order;
+  });
+  nu::MessageLoop::Run();
+  // The reset task runs at about 80ms, after the task at 60ms.
+  EXPECT_EQ(reset_order, 2);
+}
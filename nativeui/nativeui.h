@@ -5,8 +5,10 @@
 #ifndef NATIVEUI_NATIVEUI_H_
 #define NATIVEUI_NATIVEUI_H_
 
+#include "nativeui/animation.h"
 #include "nativeui/app.h"
 #include "nativeui/browser.h"
+#include "nativeui/buffer.h"
 #include "nativeui/button.h"
 #include "nativeui/entry.h"
 #include "nativeui/events/event.h"
@@ -18,7 +20,10 @@
 #include "nativeui/gfx/font.h"
 #include "nativeui/gfx/geometry/insets.h"
 #include "nativeui/gfx/image.h"
+#include "nativeui/gfx/image_cache.h"
 #include "nativeui/gfx/painter.h"
+#include "nativeui/gfx/path.h"
+#include "nativeui/gfx/pixel_ops.h"
 #include "nativeui/group.h"
 #include "nativeui/label.h"
 #include "nativeui/lifetime.h"
@@ -31,6 +36,7 @@
 #include "nativeui/scroll.h"
 #include "nativeui/state.h"
 #include "nativeui/text_edit.h"
+#include "nativeui/thread_pool.h"
 #include "nativeui/window.h"
 
 #if defined(OS_MACOSX)
@@ -36,6 +36,7 @@ ProtocolAsarJob::ProtocolAsarJob(const base::FilePath& asar,
   // Seek to the position of the path.
   file_.Seek(base::File::FROM_BEGIN, info.offset);
   path_ = base::FilePath::FromUTF8Unsafe(path);
+  content_offset_ = info.offset;
   content_length_ = info.size;
 }
 
@@ -48,10 +49,12 @@ bool ProtocolAsarJob::SetDecipher(const std::string& key,
 }
 
 bool ProtocolAsarJob::Start() {
-  if (!aes_.IsValid())
-    return ProtocolFileJob::Start();
   if (!file_.IsValid())
     return false;
+  // Archives are not modified while being used, so it is safe to map them.
+  MapContent();
+  if (!aes_.IsValid())
+    return ProtocolFileJob::Start();
   // Don't pass content length when stream is encrypted, since the decrypted
   // size might be smaller.
   notify_content_length(-1);
@@ -5,6 +5,12 @@
 
 #include "nativeui/protocol_file_job.h"
 
+#include <string.h>
+
+#include <utility>
+
+#include "base/files/memory_mapped_file.h"
+#include "base/memory/ptr_util.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 
@@ -182,6 +188,12 @@ size_t ProtocolFileJob::Read(void* buf, size_t buf_size) {
     return 0;
   if (content_length_ < static_cast<int64_t>(buf_size))
     buf_size = content_length_;
+  if (mapped_) {
+    memcpy(buf, mapped_->data() + mapped_pos_, buf_size);
+    mapped_pos_ += buf_size;
+    content_length_ -= buf_size;
+    return buf_size;
+  }
   int nread = file_.ReadAtCurrentPos(static_cast<char*>(buf),
                                      static_cast<int>(buf_size));
   if (nread > 0) {
@@ -193,4 +205,20 @@ size_t ProtocolFileJob::Read(void* buf, size_t buf_size) {
   }
 }
 
+void ProtocolFileJob::MapContent() {
+  // Empty content can not be mapped.
+  if (mapped_ || !file_.IsValid() || content_length_ <= 0)
+    return;
+  base::MemoryMappedFile::Region region;
+  region.offset = content_offset_;
+  region.size = static_cast<decltype(region.size)>(content_length_);
+  auto mapped = base::MakeUnique<base::MemoryMappedFile>();
+  if (mapped->Initialize(file_.Duplicate(), region))
+    mapped_ = std::move(mapped);
+}
+
+bool ProtocolFileJob::IsReadThreadSafe() const {
+  return true;
+}
+
 }  // namespace nu
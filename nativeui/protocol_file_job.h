@@ -5,12 +5,17 @@
 #ifndef NATIVEUI_PROTOCOL_FILE_JOB_H_
 #define NATIVEUI_PROTOCOL_FILE_JOB_H_
 
+#include <memory>
 #include <string>
 
 #include "base/files/file.h"
 #include "base/files/file_path.h"
 #include "nativeui/protocol_job.h"
 
+namespace base {
+class MemoryMappedFile;
+}
+
 namespace nu {
 
 // Serve file for the protocol request.
@@ -23,13 +28,27 @@ class NATIVEUI_EXPORT ProtocolFileJob : public ProtocolJob {
   void Kill() override;
   bool GetMimeType(std::string* mime_type) override;
   size_t Read(void* buf, size_t buf_size) override;
+  bool IsReadThreadSafe() const override;
 
  protected:
   ~ProtocolFileJob() override;
 
+  // Map the content into memory so reads are just copies, the file is read
+  // normally if it can not be mapped.
+  //
+  // Only use it for files that are never modified while being served, like
+  // asar archives. Reading a mapped file that has been truncated raises
+  // SIGBUS, while read() would just return less data. So plain files served
+  // by ProtocolFileJob are not mapped.
+  void MapContent();
+
   base::FilePath path_;
   base::File file_;
+  int64_t content_offset_ = 0;
   int64_t content_length_ = 0;
+
+  std::unique_ptr<base::MemoryMappedFile> mapped_;
+  size_t mapped_pos_ = 0;
 };
 
 }  // namespace nu
@@ -39,6 +39,10 @@ bool ProtocolJob::Start() {
 void ProtocolJob::Kill() {
 }
 
+bool ProtocolJob::IsReadThreadSafe() const {
+  return false;
+}
+
 void ProtocolJob::Plug(std::function<void(int)> func) {
   notify_content_length = std::move(func);
 }
@@ -74,4 +78,21 @@ size_t ProtocolStringJob::Read(void* buf, size_t buf_size) {
   return nread;
 }
 
+bool ProtocolStringJob::IsReadThreadSafe() const {
+  return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// ProtocolBufferJob implementation.
+
+ProtocolBufferJob::ProtocolBufferJob(const std::string& mime_type,
+                                     const Buffer& content)
+    : ProtocolStringJob(mime_type,
+                        std::string(static_cast<const char*>(content.content()),
+                                    content.size())) {
+}
+
+ProtocolBufferJob::~ProtocolBufferJob() {
+}
+
 }  // namespace nu
@@ -10,6 +10,7 @@
 
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
+#include "nativeui/buffer.h"
 #include "nativeui/nativeui_export.h"
 
 namespace nu {
@@ -23,6 +24,11 @@ class NATIVEUI_EXPORT ProtocolJob : public base::RefCounted<ProtocolJob> {
   virtual bool GetMimeType(std::string* mime_type) = 0;
   virtual size_t Read(void* buf, size_t buf_size) = 0;
 
+  // Whether Read can be called on the workers of ThreadPool, which schedule
+  // reads by the priority of requests. Otherwise the platform decides where
+  // to call Read. Reads of one job never run at the same time.
+  virtual bool IsReadThreadSafe() const;
+
   // Internal: Used by Browser implementations to plug adapters.
   void Plug(std::function<void(int)> start);
 
@@ -53,6 +59,7 @@ class NATIVEUI_EXPORT ProtocolStringJob : public ProtocolJob {
   bool Start() override;
   bool GetMimeType(std::string* mime_type) override;
   size_t Read(void* buf, size_t buf_size) override;
+  bool IsReadThreadSafe() const override;
 
  protected:
   ~ProtocolStringJob() override;
@@ -63,6 +70,16 @@ class NATIVEUI_EXPORT ProtocolStringJob : public ProtocolJob {
   size_t pos_ = 0;
 };
 
+// Use binary data as response, so pages can fetch() it as ArrayBuffer. The
+// |content| is copied so it does not have to outlive the job.
+class NATIVEUI_EXPORT ProtocolBufferJob : public ProtocolStringJob {
+ public:
+  ProtocolBufferJob(const std::string& mime_type, const Buffer& content);
+
+ protected:
+  ~ProtocolBufferJob() override;
+};
+
 }  // namespace nu
 
 #endif  // NATIVEUI_PROTOCOL_JOB_H_
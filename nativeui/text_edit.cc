@@ -4,8 +4,18 @@
 
 #include "nativeui/text_edit.h"
 
+#include <algorithm>
+
 namespace nu {
 
+namespace {
+
+// Allow the lines to exceed the limit by 1/8 before trimming, so old lines are
+// removed in bulk instead of on every frame.
+const int kTrimSlackRatio = 8;
+
+}  // namespace
+
 // static
 const char TextEdit::kClassName[] = "TextEdit";
 
@@ -13,4 +23,38 @@ const char* TextEdit::GetClassName() const {
   return kClassName;
 }
 
+void TextEdit::AppendText(const std::string& text) {
+  pending_text_ += text;
+  if (!flush_scheduled_) {
+    flush_scheduled_ = true;
+    PlatformScheduleFlush();
+  }
+}
+
+void TextEdit::FlushAppendedText() {
+  flush_scheduled_ = false;
+  if (pending_text_.empty())
+    return;
+  bool scrolled_to_end = PlatformIsScrolledToEnd();
+  std::string text;
+  text.swap(pending_text_);
+  PlatformAppendText(text);
+  if (max_lines_ > 0) {
+    int lines = PlatformGetLineCount();
+    if (lines > max_lines_ + max_lines_ / kTrimSlackRatio)
+      PlatformDeleteLines(lines - max_lines_);
+  }
+  if (scrolled_to_end)
+    PlatformScrollToEnd();
+  on_text_change.Emit(this);
+}
+
+void TextEdit::SetMaxLines(int max_lines) {
+  max_lines_ = std::max(max_lines, 0);
+}
+
+int TextEdit::GetMaxLines() const {
+  return max_lines_;
+}
+
 }  // namespace nu
@@ -30,6 +30,9 @@ class NATIVEUI_EXPORT TextEdit : public View {
   void Undo();
   bool CanUndo() const;
 
+  // Limit the undo history, 0 means unlimited.
+  void SetUndoLimit(int max_actions, int max_bytes);
+
   void Cut();
   void Copy();
   void Paste();
@@ -43,11 +46,39 @@ class NATIVEUI_EXPORT TextEdit : public View {
   void Delete();
   void DeleteRange(int start, int end);
 
+  // Append text to the end for showing logs, the text is buffered and flushed
+  // once per frame, without recording undo actions. The view keeps scrolled
+  // to the end if it was at the end before appending.
+  void AppendText(const std::string& text);
+  // Write the buffered text immediately.
+  void FlushAppendedText();
+
+  // Limit the number of lines kept when appending text, old lines are removed
+  // from the front in bulk. 0 means unlimited.
+  void SetMaxLines(int max_lines);
+  int GetMaxLines() const;
+
   // Events.
   Signal<void(TextEdit*)> on_text_change;
 
  protected:
   ~TextEdit() override;
+
+ private:
+  // Requests FlushAppendedText to be called before next frame.
+  void PlatformScheduleFlush();
+
+  // Modify text without emitting on_text_change or recording undo actions.
+  void PlatformAppendText(const std::string& text);
+  void PlatformDeleteLines(int count);
+  int PlatformGetLineCount() const;
+
+  bool PlatformIsScrolledToEnd() const;
+  void PlatformScrollToEnd();
+
+  std::string pending_text_;
+  bool flush_scheduled_ = false;
+  int max_lines_ = 0;
 };
 
 }  // namespace nu
@@ -0,0 +1,83 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <string>
+
+#include "base/logging.h"
+#include "base/timer/elapsed_timer.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+#if defined(OS_LINUX)
+#include <gtk/gtk.h>
+
+#include "nativeui/gtk/undoable_text_buffer.h"
+#endif
+
+namespace {
+
+const int kTextSize = 10 * 1024 * 1024;
+const int kIterations = 10;
+
+}  // namespace
+
+class TextEditPerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    edit_ = new nu::TextEdit;
+    window_ = new nu::Window(nu::Window::Options());
+    window_->SetContentView(edit_.get());
+  }
+
+  size_t GetUndoMemoryUsage() const {
+#if defined(OS_LINUX)
+    GtkTextBuffer* buffer = gtk_text_view_get_buffer(GTK_TEXT_VIEW(
+        g_object_get_data(G_OBJECT(edit_->GetNative()), "text-view")));
+    return nu::TextBufferGetUndoMemoryUsage(buffer);
+#else
+    return 0;
+#endif
+  }
+
+  // Paste and delete a large chunk of text repeatedly.
+  void PasteAndDelete(const std::string& label) {
+    std::string text(kTextSize, 'a');
+    base::ElapsedTimer timer;
+    for (int i = 0; i < kIterations; ++i) {
+      edit_->InsertText(text);
+      edit_->SelectAll();
+      edit_->Delete();
+    }
+    LOG(INFO) << label << ": " << timer.Elapsed().InMilliseconds() << "ms, "
+              << GetUndoMemoryUsage() / 1024 << "KB in undo history";
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::TextEdit> edit_;
+  scoped_refptr<nu::Window> window_;
+};
+
+TEST_F(TextEditPerfTest, PasteAndDeleteUnlimited) {
+  PasteAndDelete("Unlimited");
+}
+
+TEST_F(TextEditPerfTest, PasteAndDeleteLimited) {
+  edit_->SetUndoLimit(100, kTextSize * 2);
+  PasteAndDelete("Limited");
+  EXPECT_LE(GetUndoMemoryUsage(), static_cast<size_t>(kTextSize * 2));
+}
+
+TEST_F(TextEditPerfTest, AppendLines) {
+  edit_->SetMaxLines(10000);
+  base::ElapsedTimer timer;
+  for (int i = 0; i < 50000; ++i) {
+    edit_->AppendText("2018-01-01 00:00:00 INFO Lorem ipsum dolor sit amet\n");
+    if (i % 1000 == 0)  // simulate a frame
+      edit_->FlushAppendedText();
+  }
+  edit_->FlushAppendedText();
+  LOG(INFO) << "Append 50000 lines: " << timer.Elapsed().InMilliseconds()
+            << "ms";
+}
@@ -90,3 +90,93 @@ TEST_F(TextEditTest, Undo) {
   EXPECT_EQ(edit_->CanUndo(), true);
   EXPECT_EQ(edit_->CanRedo(), false);
 }
+
+TEST_F(TextEditTest, UndoLimit) {
+  edit_->SetUndoLimit(1, 0);
+  edit_->InsertTextAt("a", 0);
+  edit_->InsertTextAt("b", 0);
+  EXPECT_EQ(edit_->CanUndo(), true);
+#if defined(OS_LINUX)
+  edit_->Undo();
+  EXPECT_EQ(edit_->GetText(), "a");
+  EXPECT_EQ(edit_->CanUndo(), false);
+#endif
+}
+
+#if defined(OS_LINUX)
+TEST_F(TextEditTest, UndoLimitMerge) {
+  // Adjacent actions are merged instead of dropped. Typing "a" and "b" are
+  // not merged when inserted, so there are 3 actions exceeding the limit.
+  edit_->SetUndoLimit(2, 0);
+  edit_->InsertTextAt("a", 0);
+  edit_->InsertTextAt("b", 1);
+  edit_->InsertTextAt("c", 2);
+  edit_->Undo();
+  EXPECT_EQ(edit_->GetText(), "ab");
+  EXPECT_EQ(edit_->CanUndo(), true);
+  edit_->Undo();
+  EXPECT_EQ(edit_->GetText(), "");
+  EXPECT_EQ(edit_->CanUndo(), false);
+}
+
+TEST_F(TextEditTest, UndoLimitBytesKeepsUndo) {
+  // A large redo history should not wipe the undo history.
+  edit_->InsertTextAt("a", 0);
+  edit_->InsertTextAt(std::string(4096, 'b'), 1);
+  edit_->Undo();
+  EXPECT_EQ(edit_->CanRedo(), true);
+  edit_->SetUndoLimit(0, 1024);
+  EXPECT_EQ(edit_->CanRedo(), false);
+  EXPECT_EQ(edit_->CanUndo(), true);
+  edit_->Undo();
+  EXPECT_EQ(edit_->GetText(), "");
+}
+#endif
+
+TEST_F(TextEditTest, AppendText) {
+  edit_->InsertText("a");
+  edit_->AppendText("b");
+  edit_->AppendText("c");
+  edit_->FlushAppendedText();
+  EXPECT_EQ(edit_->GetText(), "abc");
+#if defined(OS_LINUX)
+  // Appended text is not recorded.
+  edit_->Undo();
+  EXPECT_EQ(edit_->GetText(), "bc");
+  EXPECT_EQ(edit_->CanUndo(), false);
+#endif
+}
+
+TEST_F(TextEditTest, AppendTextChangeEvent) {
+  int changes = 0;
+  edit_->on_text_change.Connect([&](nu::TextEdit*) { ++changes; });
+  edit_->AppendText("ab");
+  edit_->FlushAppendedText();
+  EXPECT_EQ(changes, 1);
+  EXPECT_EQ(edit_->GetText(), "ab");
+}
+
+TEST_F(TextEditTest, AppendTextHidden) {
+  // The window is not shown, appended text is still flushed.
+  int changes = 0;
+  edit_->on_text_change.Connect([&](nu::TextEdit*) {
+    ++changes;
+    nu::MessageLoop::Quit();
+  });
+  edit_->AppendText("a");
+  edit_->AppendText("b");
+  nu::MessageLoop::Run();
+  EXPECT_EQ(changes, 1);
+  EXPECT_EQ(edit_->GetText(), "ab");
+}
+
+TEST_F(TextEditTest, MaxLines) {
+  EXPECT_EQ(edit_->GetMaxLines(), 0);
+  edit_->SetMaxLines(2);
+  edit_->AppendText("1\n2\n3\n");
+  edit_->FlushAppendedText();
+  EXPECT_EQ(edit_->GetText(), "2\n3\n");
+  edit_->AppendText("4");
+  edit_->FlushAppendedText();
+  EXPECT_EQ(edit_->GetText(), "3\n4");
+}
@@ -0,0 +1,184 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/thread_pool.h"
+
+#include <algorithm>
+
+#include "base/containers/circular_deque.h"
+#include "base/lazy_instance.h"
+#include "base/logging.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "base/sys_info.h"
+#include "base/threading/platform_thread.h"
+#include "nativeui/message_loop.h"
+
+namespace nu {
+
+namespace {
+
+const int kMaxWorkerCount = 64;
+const int kPriorityCount = static_cast<int>(ThreadPool::Priority::High) + 1;
+
+struct WorkItem {
+  bool has_owner = false;
+  std::weak_ptr<void> owner;
+  ThreadPool::Task work;
+  ThreadPool::Task reply;
+};
+
+// Leave one processor for the GUI thread.
+int GetDefaultWorkerCount() {
+  return std::min(std::max(base::SysInfo::NumberOfProcessors() - 1, 2), 8);
+}
+
+// Worker threads are started on demand and never joined, a worker quits when
+// there are more workers than wanted.
+class WorkerPool : public base::PlatformThread::Delegate {
+ public:
+  WorkerPool() : cond_(&lock_), worker_count_(GetDefaultWorkerCount()) {}
+
+  void SetWorkerCount(int count) {
+    base::AutoLock auto_lock(lock_);
+    worker_count_ = std::min(std::max(count, 1), kMaxWorkerCount);
+    // Wake up idle workers so extra ones can quit.
+    cond_.Broadcast();
+    while (running_workers_ < worker_count_ &&
+           running_workers_ - idle_workers_ < pending_items_)
+      StartWorker();
+  }
+
+  int GetWorkerCount() {
+    base::AutoLock auto_lock(lock_);
+    return worker_count_;
+  }
+
+  void Post(WorkItem item, ThreadPool::Priority priority) {
+    base::AutoLock auto_lock(lock_);
+    queues_[static_cast<int>(priority)].push_back(std::move(item));
+    ++pending_items_;
+    if (idle_workers_ > 0)
+      cond_.Signal();
+    else if (running_workers_ < worker_count_)
+      StartWorker();
+  }
+
+ private:
+  // base::PlatformThread::Delegate:
+  void ThreadMain() override {
+    base::PlatformThread::SetName("NativeUIWorker");
+    WorkItem item;
+    while (TakeItem(&item))
+      RunItem(&item);
+  }
+
+  // Block until there is an item to run, returns false if the worker should
+  // quit.
+  bool TakeItem(WorkItem* item) {
+    base::AutoLock auto_lock(lock_);
+    while (pending_items_ == 0 && running_workers_ <= worker_count_) {
+      ++idle_workers_;
+      cond_.Wait();
+      --idle_workers_;
+    }
+    if (running_workers_ > worker_count_) {
+      --running_workers_;
+      // Pass the wakeup to other workers in case it was meant for an item.
+      if (pending_items_ > 0)
+        cond_.Signal();
+      return false;
+    }
+    for (int i = kPriorityCount - 1; i >= 0; --i) {
+      if (!queues_[i].empty()) {
+        *item = std::move(queues_[i].front());
+        queues_[i].pop_front();
+        break;
+      }
+    }
+    --pending_items_;
+    return true;
+  }
+
+  void RunItem(WorkItem* item) {
+    if (item->work && !(item->has_owner && item->owner.expired()))
+      item->work();
+    item->work = nullptr;
+    if (!item->reply)
+      return;
+    // The reply is always sent back even if the owner has gone, so it is
+    // destroyed on the GUI thread where it was created. Move it into the
+    // task instead of copying, otherwise the worker would keep a reference
+    // that might be the last one.
+    bool has_owner = item->has_owner;
+    MessageLoop::PostTask([has_owner,
+                           owner = std::move(item->owner),
+                           reply = std::move(item->reply)]() {
+      if (!(has_owner && owner.expired()))
+        reply();
+    });
+  }
+
+  void StartWorker() {
+    lock_.AssertAcquired();
+    if (base::PlatformThread::CreateNonJoinable(0, this))
+      ++running_workers_;
+    else
+      LOG(ERROR) << "Failed to create worker thread";
+  }
+
+  base::Lock lock_;
+  base::ConditionVariable cond_;
+
+  int worker_count_;
+  int running_workers_ = 0;
+  int idle_workers_ = 0;
+  int pending_items_ = 0;
+  base::circular_deque<WorkItem> queues_[kPriorityCount];
+
+  DISALLOW_COPY_AND_ASSIGN(WorkerPool);
+};
+
+base::LazyInstance<WorkerPool>::Leaky g_worker_pool = LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+// static
+void ThreadPool::SetWorkerCount(int count) {
+  g_worker_pool.Get().SetWorkerCount(count);
+}
+
+// static
+int ThreadPool::GetWorkerCount() {
+  return g_worker_pool.Get().GetWorkerCount();
+}
+
+// static
+void ThreadPool::PostTask(Task work, Priority priority) {
+  WorkItem item;
+  item.work = std::move(work);
+  g_worker_pool.Get().Post(std::move(item), priority);
+}
+
+// static
+void ThreadPool::PostTaskAndReply(Task work, Task reply, Priority priority) {
+  WorkItem item;
+  item.work = std::move(work);
+  item.reply = std::move(reply);
+  g_worker_pool.Get().Post(std::move(item), priority);
+}
+
+// static
+void ThreadPool::PostTaskAndReplyWithOwner(std::weak_ptr<void> owner,
+                                           Task work, Task reply,
+                                           Priority priority) {
+  WorkItem item;
+  item.has_owner = true;
+  item.owner = std::move(owner);
+  item.work = std::move(work);
+  item.reply = std::move(reply);
+  g_worker_pool.Get().Post(std::move(item), priority);
+}
+
+}  // namespace nu
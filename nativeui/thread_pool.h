@@ -0,0 +1,69 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_THREAD_POOL_H_
+#define NATIVEUI_THREAD_POOL_H_
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "base/macros.h"
+#include "nativeui/nativeui_export.h"
+
+namespace nu {
+
+// Run blocking work on worker threads and get the result back on the GUI
+// thread. All methods are thread-safe.
+class NATIVEUI_EXPORT ThreadPool {
+ public:
+  // Function type for tasks.
+  using Task = std::function<void()>;
+
+  // Tasks with higher priority are run first, tasks with the same priority
+  // are run in the order they are posted.
+  enum class Priority {
+    Low,
+    Normal,
+    High,
+  };
+
+  // Change the number of worker threads, |count| is clamped to [1, 64]. By
+  // default it is decided by the number of processors.
+  static void SetWorkerCount(int count);
+  static int GetWorkerCount();
+
+  // Run |work| on a worker thread.
+  static void PostTask(Task work, Priority priority = Priority::Normal);
+
+  // Run |work| on a worker thread, and then |reply| on the GUI thread.
+  static void PostTaskAndReply(Task work, Task reply,
+                               Priority priority = Priority::Normal);
+
+  // Like PostTaskAndReply, but |work| and |reply| are skipped if |owner| has
+  // expired when they are about to run. A work that has started always runs
+  // to its end.
+  static void PostTaskAndReplyWithOwner(std::weak_ptr<void> owner,
+                                        Task work, Task reply,
+                                        Priority priority = Priority::Normal);
+
+  // Pass the result of |work| to |reply|.
+  template<typename R>
+  static void PostTaskAndReplyWithResult(
+      std::function<R()> work,
+      std::function<void(R)> reply,
+      Priority priority = Priority::Normal) {
+    auto result = std::make_shared<R>();
+    PostTaskAndReply([result, work]() { *result = work(); },
+                     [result, reply]() { reply(std::move(*result)); },
+                     priority);
+  }
+
+ private:
+  DISALLOW_IMPLICIT_CONSTRUCTORS(ThreadPool);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_THREAD_POOL_H_
@@ -0,0 +1,108 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/platform_thread.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class ThreadPoolTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    worker_count_ = nu::ThreadPool::GetWorkerCount();
+  }
+
+  void TearDown() override {
+    nu::ThreadPool::SetWorkerCount(worker_count_);
+  }
+
+  int worker_count_;
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+};
+
+TEST_F(ThreadPoolTest, PostTaskAndReply) {
+  base::PlatformThreadId gui_thread = base::PlatformThread::CurrentId();
+  base::PlatformThreadId work_thread = gui_thread;
+  base::PlatformThreadId reply_thread = 0;
+  nu::ThreadPool::PostTaskAndReply(
+      [&]() { work_thread = base::PlatformThread::CurrentId(); },
+      [&]() {
+        reply_thread = base::PlatformThread::CurrentId();
+        nu::MessageLoop::Quit();
+      });
+  nu::MessageLoop::Run();
+  EXPECT_NE(work_thread, gui_thread);
+  EXPECT_EQ(reply_thread, gui_thread);
+}
+
+TEST_F(ThreadPoolTest, PostTaskAndReplyWithResult) {
+  std::string result;
+  nu::ThreadPool::PostTaskAndReplyWithResult<std::string>(
+      []() { return std::string("result"); },
+      [&](std::string value) {
+        result = value;
+        nu::MessageLoop::Quit();
+      });
+  nu::MessageLoop::Run();
+  EXPECT_EQ(result, "result");
+}
+
+TEST_F(ThreadPoolTest, Priority) {
+  nu::ThreadPool::SetWorkerCount(1);
+  EXPECT_EQ(nu::ThreadPool::GetWorkerCount(), 1);
+  // Keep the only worker busy until all tasks are posted.
+  base::WaitableEvent started(base::WaitableEvent::ResetPolicy::MANUAL,
+                              base::WaitableEvent::InitialState::NOT_SIGNALED);
+  base::WaitableEvent proceed(base::WaitableEvent::ResetPolicy::MANUAL,
+                              base::WaitableEvent::InitialState::NOT_SIGNALED);
+  nu::ThreadPool::PostTask([&]() {
+    started.Signal();
+    proceed.Wait();
+  });
+  started.Wait();
+  std::vector<int> order;
+  nu::ThreadPool::PostTaskAndReply([]() {}, [&]() { order.push_back(0); },
+                                   nu::ThreadPool::Priority::Low);
+  nu::ThreadPool::PostTaskAndReply([]() {}, [&]() { order.push_back(1); },
+                                   nu::ThreadPool::Priority::Normal);
+  nu::ThreadPool::PostTaskAndReply([]() {}, [&]() { order.push_back(2); },
+                                   nu::ThreadPool::Priority::High);
+  nu::ThreadPool::PostTaskAndReply([]() {}, [&]() {
+    order.push_back(3);
+    nu::MessageLoop::Quit();
+  }, nu::ThreadPool::Priority::High);
+  proceed.Signal();
+  nu::MessageLoop::Run();
+  EXPECT_EQ(order, std::vector<int>({2, 3, 1, 0}));
+}
+
+TEST_F(ThreadPoolTest, Owner) {
+  // With one worker the replies are posted in the order of tasks.
+  nu::ThreadPool::SetWorkerCount(1);
+  auto owner = std::make_shared<int>(0);
+  base::WaitableEvent started(base::WaitableEvent::ResetPolicy::MANUAL,
+                              base::WaitableEvent::InitialState::NOT_SIGNALED);
+  base::WaitableEvent released(base::WaitableEvent::ResetPolicy::MANUAL,
+                               base::WaitableEvent::InitialState::NOT_SIGNALED);
+  bool reply_run = false;
+  nu::ThreadPool::PostTaskAndReplyWithOwner(owner, [&]() {
+    started.Signal();
+    released.Wait();
+  }, [&]() { reply_run = true; });
+  nu::ThreadPool::PostTaskAndReply([]() {}, []() {
+    nu::MessageLoop::Quit();
+  });
+  // Release the owner while the work is running.
+  started.Wait();
+  owner.reset();
+  released.Signal();
+  nu::MessageLoop::Run();
+  EXPECT_FALSE(reply_run);
+}
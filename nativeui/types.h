@@ -26,12 +26,14 @@ typedef struct _GtkWidget GtkWidget;
 typedef struct _GtkWindow GtkWindow;
 typedef struct _PangoFontDescription PangoFontDescription;
 typedef struct _cairo_surface cairo_surface_t;
+typedef struct cairo_path cairo_path_t;
 typedef struct _cairo cairo_t;
 typedef union _GdkEvent GdkEvent;
 #endif
 
 #if defined(OS_MACOSX)
 typedef struct CGContext* CGContextRef;
+typedef struct CGPath* CGMutablePathRef;
 #ifdef __OBJC__
 @class NSBitmapImageRep;
 @class NSEvent;
@@ -72,8 +74,10 @@ class UIWindow;
 #if defined(OS_WIN)
 namespace Gdiplus {
 class Bitmap;
+class BitmapData;
 class Font;
 class Graphics;
+class GraphicsPath;
 class Image;
 }
 #endif
@@ -94,6 +98,7 @@ using NativeFileDialog = NSSavePanel*;
 using NativeView = NSView*;
 using NativeWindow = NSWindow*;
 using NativeBitmap = CGContextRef;
+using NativePath = CGMutablePathRef;
 using NativeImage = NSImage*;
 using nativeGraphicsContext = NSGraphicsContext*;
 using NativeFont = NSFont*;
@@ -106,6 +111,7 @@ using NativeFileDialog = GtkFileChooser*;
 using NativeView = GtkWidget*;
 using NativeWindow = GtkWindow*;
 using NativeBitmap = cairo_surface_t*;
+using NativePath = cairo_path_t*;
 using NativeImage = GdkPixbuf*;
 using nativeGraphicsContext = cairo_t*;
 using NativeFont = PangoFontDescription*;
@@ -117,6 +123,7 @@ using NativeFileDialog = FileDialogImpl*;
 using NativeView = ViewImpl*;
 using NativeWindow = WindowImpl*;
 using NativeBitmap = Gdiplus::Bitmap*;
+using NativePath = Gdiplus::GraphicsPath*;
 using NativeFont = Gdiplus::Font*;
 using nativeGraphicsContext = Gdiplus::Graphics*;
 using NativeImage = Gdiplus::Image*;
@@ -8,6 +8,7 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/values.h"
 
@@ -77,6 +78,14 @@ inline void GetArgument(CallContext* context, base::Value* arg,
   context->current_arg++;
 }
 
+// ArrayBuffer and typed arrays passed from pages.
+inline void GetArgument(CallContext* context, base::Value* arg,
+                        std::vector<char>* value) {
+  if (arg->is_blob())
+    *value = arg->GetBlob();
+  context->current_arg++;
+}
+
 inline void GetArgument(CallContext* context, base::Value* arg, bool* value) {
   if (arg->is_bool())
     *value = arg->GetBool();
@@ -0,0 +1,177 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/timer_wheel.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace nu {
+
+namespace {
+
+const int64_t kSlotMask = TimerWheel::kSlots - 1;
+
+}  // namespace
+
+// static
+const int TimerWheel::kLevelBits;
+const int TimerWheel::kLevels;
+const int TimerWheel::kSlots;
+const int64_t TimerWheel::kMaxDelay;
+
+TimerWheel::TimerWheel(int64_t now) : current_(now) {
+}
+
+TimerWheel::~TimerWheel() {
+}
+
+TimerWheel::TimerId TimerWheel::Add(int64_t now, int64_t delay, Task task) {
+  TimerId id = next_id_;
+  // Skip 0 and IDs still in use after wrapping.
+  do {
+    next_id_ = next_id_ == std::numeric_limits<TimerId>::max() ? 1
+                                                               : next_id_ + 1;
+  } while (timers_.find(next_id_) != timers_.end());
+  Timer* timer = new Timer;
+  timer->id = id;
+  timer->delay = std::max(delay, INT64_C(0));
+  timer->expires = now + timer->delay;
+  timer->level = -1;
+  timer->task = std::move(task);
+  timers_[id].reset(timer);
+  Insert(timer);
+  return id;
+}
+
+bool TimerWheel::Cancel(TimerId id) {
+  auto it = timers_.find(id);
+  if (it == timers_.end())
+    return false;
+  Remove(it->second.get());
+  timers_.erase(it);
+  return true;
+}
+
+bool TimerWheel::Reset(int64_t now, TimerId id) {
+  auto it = timers_.find(id);
+  if (it == timers_.end())
+    return false;
+  Timer* timer = it->second.get();
+  Remove(timer);
+  timer->expires = now + timer->delay;
+  Insert(timer);
+  return true;
+}
+
+void TimerWheel::Advance(int64_t now) {
+  while (current_ < now) {
+    // Levels below the lowest non-empty level have nothing to expire or
+    // cascade, jump to the next slot of that level directly.
+    int level = 0;
+    while (level < kLevels && level_sizes_[level] == 0)
+      ++level;
+    if (level == kLevels) {
+      current_ = now;
+      break;
+    }
+    int64_t granularity = INT64_C(1) << (kLevelBits * level);
+    int64_t next = (current_ | (granularity - 1)) + 1;
+    if (next > now) {
+      current_ = now;
+      break;
+    }
+    current_ = next;
+    if ((current_ & kSlotMask) == 0)
+      Cascade(1);
+    ExpireSlot(current_ & kSlotMask);
+  }
+}
+
+bool TimerWheel::PopExpired(Task* task) {
+  if (expired_.empty())
+    return false;
+  Timer* timer = expired_.head()->value();
+  Remove(timer);
+  *task = std::move(timer->task);
+  timers_.erase(timer->id);
+  return true;
+}
+
+int64_t TimerWheel::GetNextWakeup() const {
+  if (!expired_.empty())
+    return current_;
+  int64_t result = -1;
+  for (int level = 0; level < kLevels; ++level) {
+    if (level_sizes_[level] == 0)
+      continue;
+    int shift = kLevelBits * level;
+    int64_t index = current_ >> shift;
+    // The current slot of each level has already been processed, so timers
+    // in it belong to next round.
+    for (int i = 1; i <= kSlots; ++i) {
+      if (!slots_[level][(index + i) & kSlotMask].empty()) {
+        int64_t time = (index + i) << shift;
+        if (result == -1 || time < result)
+          result = time;
+        break;
+      }
+    }
+  }
+  return result;
+}
+
+void TimerWheel::Insert(Timer* timer) {
+  if (timer->expires <= current_) {
+    timer->level = -1;
+    expired_.Append(timer);
+    return;
+  }
+  // Timers out of the range are put in the farthest slot, which is never the
+  // slot being cascaded, and they are inserted again when it is cascaded.
+  int64_t delta = std::min(timer->expires - current_, kMaxDelay);
+  int level = 0;
+  while (level < kLevels - 1 &&
+         delta >= (INT64_C(1) << (kLevelBits * (level + 1))))
+    ++level;
+  int slot = ((current_ + delta) >> (kLevelBits * level)) & kSlotMask;
+  timer->level = level;
+  slots_[level][slot].Append(timer);
+  level_sizes_[level]++;
+}
+
+void TimerWheel::Remove(Timer* timer) {
+  timer->RemoveFromList();
+  if (timer->level >= 0)
+    level_sizes_[timer->level]--;
+  timer->level = -1;
+}
+
+void TimerWheel::Cascade(int level) {
+  if (level >= kLevels)
+    return;
+  int index = (current_ >> (kLevelBits * level)) & kSlotMask;
+  if (index == 0)
+    Cascade(level + 1);
+  // Timers in this slot expire within the span of one slot, which belong to
+  // lower levels now.
+  base::LinkedList<Timer>& slot = slots_[level][index];
+  while (!slot.empty()) {
+    Timer* timer = slot.head()->value();
+    Remove(timer);
+    Insert(timer);
+  }
+}
+
+void TimerWheel::ExpireSlot(int index) {
+  base::LinkedList<Timer>& slot = slots_[0][index];
+  while (!slot.empty()) {
+    Timer* timer = slot.head()->value();
+    Remove(timer);
+    expired_.Append(timer);
+  }
+}
+
+}  // namespace nu
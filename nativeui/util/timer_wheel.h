@@ -0,0 +1,91 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_UTIL_TIMER_WHEEL_H_
+#define NATIVEUI_UTIL_TIMER_WHEEL_H_
+
+#include <stdint.h>
+
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+#include "base/containers/linked_list.h"
+#include "base/macros.h"
+#include "nativeui/nativeui_export.h"
+
+namespace nu {
+
+// A hierarchical timer wheel with millisecond resolution, adding, cancelling
+// and expiring timers are all O(1).
+//
+// The wheel does not read clock by itself, callers pass the current time in
+// milliseconds. It is not thread-safe.
+class NATIVEUI_EXPORT TimerWheel {
+ public:
+  using Task = std::function<void()>;
+  using TimerId = int;
+
+  // Number of levels and slots per level, the wheel covers about 12 days.
+  // Timers with longer delays wait in the farthest slot, and are inserted
+  // again when the slot is cascaded.
+  static const int kLevelBits = 6;
+  static const int kLevels = 5;
+  static const int kSlots = 1 << kLevelBits;
+  static const int64_t kMaxDelay = (INT64_C(1) << (kLevelBits * kLevels)) - 1;
+
+  explicit TimerWheel(int64_t now);
+  ~TimerWheel();
+
+  // Add a |task| that expires after |delay| ms, returns an ID that is never 0.
+  TimerId Add(int64_t now, int64_t delay, Task task);
+
+  // Remove the timer, returns false if it does not exist or has run.
+  bool Cancel(TimerId id);
+
+  // Restart the timer with its original delay, returns false if it does not
+  // exist or has run.
+  bool Reset(int64_t now, TimerId id);
+
+  // Move the wheel forward to |now| and collect the expired timers.
+  void Advance(int64_t now);
+
+  // Take the earliest expired timer's task, returns false if there is none.
+  bool PopExpired(Task* task);
+
+  // Return the time when Advance should be called next, it is either the time
+  // of the earliest timer, or the time to move timers to a lower level. -1 is
+  // returned if there is no timer.
+  int64_t GetNextWakeup() const;
+
+  bool HasExpired() const { return !expired_.empty(); }
+  size_t size() const { return timers_.size(); }
+
+ private:
+  struct Timer : public base::LinkNode<Timer> {
+    TimerId id;
+    int64_t delay;
+    int64_t expires;
+    int level;  // -1 for expired timers
+    Task task;
+  };
+
+  void Insert(Timer* timer);
+  void Remove(Timer* timer);
+  void Cascade(int level);
+  void ExpireSlot(int slot);
+
+  int64_t current_;
+  TimerId next_id_ = 1;
+  std::unordered_map<TimerId, std::unique_ptr<Timer>> timers_;
+  base::LinkedList<Timer> slots_[kLevels][kSlots];
+  size_t level_sizes_[kLevels] = {0};
+  base::LinkedList<Timer> expired_;
+
+  DISALLOW_COPY_AND_ASSIGN(TimerWheel);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_UTIL_TIMER_WHEEL_H_
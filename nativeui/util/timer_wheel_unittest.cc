@@ -0,0 +1,100 @@
+// Copyright 2018 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/timer_wheel.h"
+
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+class TimerWheelTest : public testing::Test {
+ protected:
+  // Advance the wheel to |now| and run expired tasks.
+  void RunUntil(int64_t now) {
+    wheel_.Advance(now);
+    nu::TimerWheel::Task task;
+    while (wheel_.PopExpired(&task))
+      task();
+  }
+
+  // Add a task that records the time when it runs.
+  nu::TimerWheel::TimerId Add(int64_t delay) {
+    return wheel_.Add(now_, delay, [this]() { fired_.push_back(now_); });
+  }
+
+  int64_t now_ = 1000;
+  nu::TimerWheel wheel_{1000};
+  std::vector<int64_t> fired_;
+};
+
+TEST_F(TimerWheelTest, Expire) {
+  Add(10);
+  Add(100);
+  Add(5000);
+  EXPECT_EQ(wheel_.GetNextWakeup(), 1010);
+  for (now_ = 1001; now_ <= 7000; ++now_)
+    RunUntil(now_);
+  EXPECT_EQ(fired_, std::vector<int64_t>({1010, 1100, 6000}));
+  EXPECT_EQ(wheel_.size(), 0u);
+  EXPECT_EQ(wheel_.GetNextWakeup(), -1);
+}
+
+TEST_F(TimerWheelTest, ExpireAfterJump) {
+  Add(100000);
+  now_ = 200000;
+  RunUntil(now_);
+  EXPECT_EQ(fired_.size(), 1u);
+}
+
+TEST_F(TimerWheelTest, WakeupNeverLate) {
+  for (int64_t delay : {1, 63, 64, 65, 4095, 4096, 300000, 20000000})
+    Add(delay);
+  while (wheel_.size() > 0) {
+    int64_t next = wheel_.GetNextWakeup();
+    ASSERT_GT(next, now_);
+    now_ = next;
+    RunUntil(now_);
+  }
+  EXPECT_EQ(fired_, std::vector<int64_t>({1001, 1063, 1064, 1065, 5095, 5096,
+                                          301000, 20001000}));
+}
+
+TEST_F(TimerWheelTest, BeyondMaxDelay) {
+  // Delays longer than the wheel are not clamped.
+  int64_t delays[] = { nu::TimerWheel::kMaxDelay + 5000,
+                       nu::TimerWheel::kMaxDelay * 2 + 7 };
+  for (int64_t delay : delays)
+    Add(delay);
+  while (wheel_.size() > 0) {
+    int64_t next = wheel_.GetNextWakeup();
+    ASSERT_GT(next, now_);
+    now_ = next;
+    RunUntil(now_);
+  }
+  EXPECT_EQ(fired_, std::vector<int64_t>({1000 + delays[0],
+                                          1000 + delays[1]}));
+}
+
+TEST_F(TimerWheelTest, Cancel) {
+  nu::TimerWheel::TimerId id = Add(10);
+  Add(20);
+  EXPECT_TRUE(wheel_.Cancel(id));
+  EXPECT_FALSE(wheel_.Cancel(id));
+  RunUntil(2000);
+  EXPECT_EQ(fired_.size(), 1u);
+}
+
+TEST_F(TimerWheelTest, Reset) {
+  nu::TimerWheel::TimerId id = Add(100);
+  now_ = 1050;
+  RunUntil(now_);
+  EXPECT_TRUE(wheel_.Reset(now_, id));
+  now_ = 1100;
+  RunUntil(now_);
+  EXPECT_TRUE(fired_.empty());
+  now_ = 1150;
+  RunUntil(now_);
+  EXPECT_EQ(fired_, std::vector<int64_t>({1150}));
+  EXPECT_FALSE(wheel_.Reset(now_, id));
+}
@@ -12,6 +12,13 @@
 
 namespace nu {
 
+namespace {
+
+// The default undo limit of RichEdit.
+const int kDefaultUndoLimit = 100;
+
+}  // namespace
+
 EditView::EditView(View* delegate, DWORD styles)
     : SubwinView((LoadRichEdit(), delegate),  // load dll before constructor
                  MSFTEDIT_CLASS,
@@ -48,6 +55,12 @@ bool EditView::CanUndo() const {
   return ::SendMessage(hwnd(), EM_CANUNDO, 0, 0L) != 0;
 }
 
+void EditView::SetUndoLimit(int max_actions) {
+  // RichEdit disables undo when passing 0, use its default limit instead.
+  ::SendMessage(hwnd(), EM_SETUNDOLIMIT,
+                max_actions > 0 ? max_actions : kDefaultUndoLimit, 0L);
+}
+
 void EditView::Cut() {
   ::SendMessage(hwnd(), WM_CUT, 0, 0L);
 }
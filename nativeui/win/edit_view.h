@@ -24,6 +24,7 @@ class EditView : public SubwinView {
   bool CanRedo() const;
   void Undo();
   bool CanUndo() const;
+  void SetUndoLimit(int max_actions);
 
   void Cut();
   void Copy();
@@ -5,14 +5,77 @@
 #include "nativeui/message_loop.h"
 
 #include <windows.h>
+#include <dwmapi.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "base/lazy_instance.h"
+#include "base/logging.h"
+#include "base/time/time.h"
 
 namespace nu {
 
+namespace {
+
+const wchar_t kTaskWindowClass[] = L"YueMessageLoopTaskWindow";
+const UINT kRunTasksMessage = WM_USER + 1;
+// WPARAM is the timer id, LPARAM is the delay in ms.
+const UINT kSetTimerMessage = WM_USER + 2;
+// WPARAM is the timer id.
+const UINT kKillTimerMessage = WM_USER + 3;
+
+// Timers only fire on the thread creating them, so tasks are queued and
+// timers are managed by a message-only window created on the GUI thread.
+HWND g_task_window = NULL;
+base::LazyInstance<base::Lock>::Leaky g_tasks_lock = LAZY_INSTANCE_INITIALIZER;
+base::LazyInstance<std::vector<MessageLoop::Task>>::Leaky g_pending_tasks =
+    LAZY_INSTANCE_INITIALIZER;
+
+// All windows are painted with the same vblank, so frame callbacks are
+// batched globally.
+base::LazyInstance<std::vector<MessageLoop::FrameCallback>>::Leaky
+    g_frame_callbacks = LAZY_INSTANCE_INITIALIZER;
+
+// Return the milliseconds until next vblank.
+int GetDelayToNextFrame() {
+  DWM_TIMING_INFO info = { sizeof(info) };
+  LARGE_INTEGER frequency, now;
+  if (FAILED(::DwmGetCompositionTimingInfo(NULL, &info)) ||
+      info.qpcRefreshPeriod == 0 ||
+      !::QueryPerformanceFrequency(&frequency) ||
+      !::QueryPerformanceCounter(&now))
+    return 16;
+  int64_t period = static_cast<int64_t>(info.qpcRefreshPeriod);
+  int64_t elapsed =
+      (now.QuadPart - static_cast<int64_t>(info.qpcVBlank)) % period;
+  if (elapsed < 0)
+    elapsed += period;
+  return std::max(
+      static_cast<int>((period - elapsed) * 1000 / frequency.QuadPart), 1);
+}
+
+void RunFrameCallbacks() {
+  std::vector<MessageLoop::FrameCallback> callbacks;
+  callbacks.swap(g_frame_callbacks.Get());
+  double frame_time = (base::TimeTicks::Now() - base::TimeTicks())
+                      .InMillisecondsF();
+  for (const auto& callback : callbacks)
+    callback(frame_time);
+}
+
+}  // namespace
+
 // static
 base::Lock MessageLoop::lock_;
 
 // static
-std::unordered_map<UINT_PTR, std::function<void()>> MessageLoop::tasks_;
+MessageLoop::TimerId MessageLoop::next_id_ = 1;
+
+// static
+std::unordered_map<MessageLoop::TimerId, MessageLoop::DelayedTask>
+    MessageLoop::tasks_;
 
 // static
 void MessageLoop::Run() {
@@ -29,25 +92,122 @@ void MessageLoop::Quit() {
 }
 
 // static
-void MessageLoop::PostTask(const std::function<void()>& task) {
-  PostDelayedTask(USER_TIMER_MINIMUM, task);
+void MessageLoop::PostTask(Task task) {
+  DCHECK(g_task_window) << "State must be created before posting tasks";
+  bool was_empty;
+  {
+    base::AutoLock auto_lock(g_tasks_lock.Get());
+    std::vector<Task>& tasks = g_pending_tasks.Get();
+    was_empty = tasks.empty();
+    tasks.push_back(std::move(task));
+  }
+  // Only notify the window once for all tasks posted before it runs them.
+  if (was_empty)
+    ::PostMessage(g_task_window, kRunTasksMessage, 0, 0);
+}
+
+// static
+MessageLoop::TimerId MessageLoop::PostDelayedTask(int ms, Task task) {
+  DCHECK(g_task_window) << "State must be created before posting tasks";
+  TimerId id;
+  {
+    base::AutoLock auto_lock(lock_);
+    id = next_id_++;
+    if (next_id_ <= 0)
+      next_id_ = 1;
+    tasks_[id] = {ms, std::move(task)};
+  }
+  ::PostMessage(g_task_window, kSetTimerMessage, id, ms);
+  return id;
+}
+
+// static
+void MessageLoop::CancelDelayedTask(TimerId id) {
+  {
+    base::AutoLock auto_lock(lock_);
+    if (tasks_.erase(id) == 0)
+      return;
+  }
+  // A WM_TIMER already in the queue finds no task and is ignored.
+  ::PostMessage(g_task_window, kKillTimerMessage, id, 0);
+}
+
+// static
+void MessageLoop::ResetDelayedTask(TimerId id) {
+  int ms;
+  {
+    base::AutoLock auto_lock(lock_);
+    auto it = tasks_.find(id);
+    if (it == tasks_.end())
+      return;
+    ms = it->second.ms;
+  }
+  // Setting an existing timer of the window restarts its countdown.
+  ::PostMessage(g_task_window, kSetTimerMessage, id, ms);
+}
+
+// static
+void MessageLoop::RequestFrame(Window* window, FrameCallback callback) {
+  std::vector<FrameCallback>& callbacks = g_frame_callbacks.Get();
+  callbacks.push_back(std::move(callback));
+  if (callbacks.size() == 1)
+    PostDelayedTask(GetDelayToNextFrame(), &RunFrameCallbacks);
 }
 
 // static
-void MessageLoop::PostDelayedTask(int ms, const std::function<void()>& task) {
-  UINT_PTR event = ::SetTimer(NULL, NULL, ms, OnTimer);
-  base::AutoLock auto_lock(lock_);
-  tasks_[event] = task;
+void MessageLoop::CreateTaskWindow() {
+  if (g_task_window)
+    return;
+  HINSTANCE instance = ::GetModuleHandle(NULL);
+  WNDCLASSEX window_class = { sizeof(window_class) };
+  window_class.lpfnWndProc = TaskWindowProc;
+  window_class.hInstance = instance;
+  window_class.lpszClassName = kTaskWindowClass;
+  ::RegisterClassEx(&window_class);
+  g_task_window = ::CreateWindowEx(0, kTaskWindowClass, NULL, 0, 0, 0, 0, 0,
+                                   HWND_MESSAGE, NULL, instance, NULL);
+  PCHECK(g_task_window);
+}
+
+// static
+LRESULT CALLBACK MessageLoop::TaskWindowProc(HWND hwnd, UINT message,
+                                             WPARAM w_param, LPARAM l_param) {
+  switch (message) {
+    case kRunTasksMessage: {
+      std::vector<Task> tasks;
+      {
+        base::AutoLock auto_lock(g_tasks_lock.Get());
+        tasks.swap(g_pending_tasks.Get());
+      }
+      for (const auto& task : tasks)
+        task();
+      return 0;
+    }
+    case kSetTimerMessage:
+      ::SetTimer(hwnd, w_param, static_cast<UINT>(l_param), NULL);
+      return 0;
+    case kKillTimerMessage:
+      ::KillTimer(hwnd, w_param);
+      return 0;
+    case WM_TIMER:
+      ::KillTimer(hwnd, w_param);
+      OnTimer(static_cast<TimerId>(w_param));
+      return 0;
+    default:
+      return ::DefWindowProc(hwnd, message, w_param, l_param);
+  }
 }
 
 // static
-void CALLBACK MessageLoop::OnTimer(HWND, UINT, UINT_PTR event, DWORD) {
-  ::KillTimer(NULL, event);
-  std::function<void()> task;
+void MessageLoop::OnTimer(TimerId id) {
+  Task task;
   {
     base::AutoLock auto_lock(lock_);
-    task = tasks_[event];
-    tasks_.erase(event);
+    auto it = tasks_.find(id);
+    if (it == tasks_.end())
+      return;
+    task = std::move(it->second.task);
+    tasks_.erase(it);
   }
   task();
 }
@@ -11,6 +11,7 @@
 #include "base/win/windows_version.h"
 #include "nativeui/gfx/screen.h"
 #include "nativeui/gfx/win/native_theme.h"
+#include "nativeui/message_loop.h"
 #include "nativeui/win/util/class_registrar.h"
 #include "nativeui/win/util/gdiplus_holder.h"
 #include "nativeui/win/util/scoped_ole_initializer.h"
@@ -80,6 +81,8 @@ void State::PlatformInit() {
   ::InitCommonControlsEx(&config);
 
   gdiplus_holder_.reset(new GdiplusHolder);
+
+  MessageLoop::CreateTaskWindow();
 }
 
 void State::InitializeCOM() {
@@ -4,7 +4,13 @@
 
 #include "nativeui/text_edit.h"
 
+#include <richedit.h>
+
+#include <algorithm>
+
+#include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "nativeui/message_loop.h"
 #include "nativeui/win/edit_view.h"
 
 namespace nu {
@@ -27,6 +33,54 @@ class TextEditImpl : public EditView {
   }
 };
 
+// Replace the text in range without recording undo or sending EN_CHANGE,
+// the original selection is kept.
+void ReplaceRangeSilently(HWND hwnd, LONG start, LONG end,
+                          const base::string16& text) {
+  CHARRANGE selection;
+  ::SendMessage(hwnd, EM_EXGETSEL, 0, reinterpret_cast<LPARAM>(&selection));
+  LRESULT mask = ::SendMessage(hwnd, EM_GETEVENTMASK, 0, 0L);
+  ::SendMessage(hwnd, EM_SETEVENTMASK, 0, mask & ~ENM_CHANGE);
+  ::SendMessage(hwnd, WM_SETREDRAW, FALSE, 0L);
+  CHARRANGE range = { start, end };
+  ::SendMessage(hwnd, EM_EXSETSEL, 0, reinterpret_cast<LPARAM>(&range));
+  ::SendMessageW(hwnd, EM_REPLACESEL, FALSE,
+                 reinterpret_cast<LPARAM>(text.c_str()));
+  // Move the selection with the text before it.
+  if (start == end) {
+    if (start < selection.cpMin)
+      selection.cpMin += static_cast<LONG>(text.size());
+    if (start < selection.cpMax)
+      selection.cpMax += static_cast<LONG>(text.size());
+  } else {
+    selection.cpMin = std::max(selection.cpMin - (end - start), 0L);
+    selection.cpMax = std::max(selection.cpMax - (end - start), 0L);
+  }
+  ::SendMessage(hwnd, EM_EXSETSEL, 0, reinterpret_cast<LPARAM>(&selection));
+  ::SendMessage(hwnd, WM_SETREDRAW, TRUE, 0L);
+  ::InvalidateRect(hwnd, nullptr, TRUE);
+  ::SendMessage(hwnd, EM_SETEVENTMASK, 0, mask);
+}
+
+// Return the text with the paragraph breaks as single "\r", so indexes in it
+// are character positions.
+base::string16 GetPlainText(HWND hwnd) {
+  GETTEXTLENGTHEX gtl = { GTL_NUMCHARS | GTL_PRECISE, 1200 };
+  LONG length = static_cast<LONG>(
+      ::SendMessage(hwnd, EM_GETTEXTLENGTHEX, reinterpret_cast<WPARAM>(&gtl),
+                    0L));
+  base::string16 text;
+  if (length <= 0)
+    return text;
+  GETTEXTEX gt = { static_cast<DWORD>((length + 1) * sizeof(wchar_t)),
+                   GT_DEFAULT, 1200, nullptr, nullptr };
+  LRESULT copied = ::SendMessageW(
+      hwnd, EM_GETTEXTEX, reinterpret_cast<WPARAM>(&gt),
+      reinterpret_cast<LPARAM>(base::WriteInto(&text, length + 1)));
+  text.resize(copied);
+  return text;
+}
+
 }  // namespace
 
 TextEdit::TextEdit() {
@@ -41,7 +95,12 @@ void TextEdit::SetText(const std::string& text) {
 }
 
 std::string TextEdit::GetText() const {
-  return static_cast<EditView*>(GetNative())->GetText();
+  // The window text uses "\r\n" for newlines, which does not match the
+  // character positions used by other APIs.
+  HWND hwnd = static_cast<SubwinView*>(GetNative())->hwnd();
+  base::string16 text = GetPlainText(hwnd);
+  std::replace(text.begin(), text.end(), L'\r', L'\n');
+  return base::UTF16ToUTF8(text);
 }
 
 void TextEdit::Redo() {
@@ -60,6 +119,10 @@ bool TextEdit::CanUndo() const {
   return static_cast<EditView*>(GetNative())->CanUndo();
 }
 
+void TextEdit::SetUndoLimit(int max_actions, int max_bytes) {
+  static_cast<EditView*>(GetNative())->SetUndoLimit(max_actions);
+}
+
 void TextEdit::Cut() {
   static_cast<EditView*>(GetNative())->Cut();
 }
@@ -118,4 +181,55 @@ void TextEdit::DeleteRange(int start, int end) {
   InsertText("");
 }
 
+void TextEdit::PlatformScheduleFlush() {
+  scoped_refptr<TextEdit> ref(this);
+  MessageLoop::PostTask([ref]() { ref->FlushAppendedText(); });
+}
+
+void TextEdit::PlatformAppendText(const std::string& text) {
+  HWND hwnd = static_cast<SubwinView*>(GetNative())->hwnd();
+  GETTEXTLENGTHEX gtl = { GTL_NUMCHARS | GTL_PRECISE, 1200 };
+  LONG length = static_cast<LONG>(
+      ::SendMessage(hwnd, EM_GETTEXTLENGTHEX, reinterpret_cast<WPARAM>(&gtl),
+                    0L));
+  ReplaceRangeSilently(hwnd, length, length, base::UTF8ToUTF16(text));
+}
+
+void TextEdit::PlatformDeleteLines(int count) {
+  // EM_LINEINDEX counts wrapped lines, so find the newlines instead.
+  HWND hwnd = static_cast<SubwinView*>(GetNative())->hwnd();
+  base::string16 text = GetPlainText(hwnd);
+  size_t end = 0;
+  for (int i = 0; i < count && end < text.size(); ++i) {
+    end = text.find(L'\r', end);
+    end = end == base::string16::npos ? text.size() : end + 1;
+  }
+  if (end > 0)
+    ReplaceRangeSilently(hwnd, 0, static_cast<LONG>(end), base::string16());
+}
+
+int TextEdit::PlatformGetLineCount() const {
+  // EM_GETLINECOUNT counts wrapped lines, so count the newlines instead.
+  HWND hwnd = static_cast<SubwinView*>(GetNative())->hwnd();
+  base::string16 text = GetPlainText(hwnd);
+  int lines = static_cast<int>(std::count(text.begin(), text.end(), L'\r'));
+  // The last line may not end with newline.
+  if (!text.empty() && text.back() != L'\r')
+    ++lines;
+  return lines;
+}
+
+bool TextEdit::PlatformIsScrolledToEnd() const {
+  HWND hwnd = static_cast<SubwinView*>(GetNative())->hwnd();
+  SCROLLINFO si = { sizeof(si), SIF_ALL };
+  if (!::GetScrollInfo(hwnd, SB_VERT, &si))
+    return true;
+  return si.nPos + static_cast<int>(si.nPage) > si.nMax;
+}
+
+void TextEdit::PlatformScrollToEnd() {
+  HWND hwnd = static_cast<SubwinView*>(GetNative())->hwnd();
+  ::SendMessage(hwnd, WM_VSCROLL, SB_BOTTOM, 0L);
+}
+
 }  // namespace nu
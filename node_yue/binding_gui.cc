@@ -40,6 +40,30 @@ struct Type<base::FilePath> {
   }
 };
 
+template<>
+struct Type<nu::Buffer> {
+  static constexpr const char* name = "Buffer";
+  static bool FromV8(v8::Local<v8::Context> context,
+                     v8::Local<v8::Value> value,
+                     nu::Buffer* out) {
+    // The memory is used directly, which stays valid during the call.
+    if (value->IsArrayBuffer()) {
+      v8::ArrayBuffer::Contents contents =
+          v8::Local<v8::ArrayBuffer>::Cast(value)->GetContents();
+      *out = nu::Buffer(contents.Data(), contents.ByteLength());
+      return true;
+    } else if (value->IsArrayBufferView()) {
+      v8::Local<v8::ArrayBufferView> view =
+          v8::Local<v8::ArrayBufferView>::Cast(value);
+      v8::ArrayBuffer::Contents contents = view->Buffer()->GetContents();
+      const char* data = static_cast<const char*>(contents.Data());
+      *out = nu::Buffer(data + view->ByteOffset(), view->ByteLength());
+      return true;
+    }
+    return false;
+  }
+};
+
 template<>
 struct Type<nu::Size> {
   static constexpr const char* name = "yue.Size";
@@ -181,7 +205,10 @@ struct Type<nu::MessageLoop> {
     Set(context, constructor,
         "quit", &nu::MessageLoop::Quit,
         "postTask", &nu::MessageLoop::PostTask,
-        "postDelayedTask", &nu::MessageLoop::PostDelayedTask);
+        "postDelayedTask", &nu::MessageLoop::PostDelayedTask,
+        "cancelDelayedTask", &nu::MessageLoop::CancelDelayedTask,
+        "resetDelayedTask", &nu::MessageLoop::ResetDelayedTask,
+        "requestFrame", &nu::MessageLoop::RequestFrame);
     // The "run" method should never be used in yode runtime.
     if (!is_yode) {
       Set(context, constructor, "run", &nu::MessageLoop::Run);
@@ -192,6 +219,20 @@ struct Type<nu::MessageLoop> {
   }
 };
 
+template<>
+struct Type<nu::ThreadPool> {
+  static constexpr const char* name = "yue.ThreadPool";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor,
+        "setWorkerCount", &nu::ThreadPool::SetWorkerCount,
+        "getWorkerCount", &nu::ThreadPool::GetWorkerCount);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+  }
+};
+
 template<>
 struct Type<nu::App::ThemeColor> {
   static constexpr const char* name = "yue.ThemeColor";
@@ -330,8 +371,7 @@ struct Type<nu::Font> {
   static void BuildConstructor(v8::Local<v8::Context> context,
                                v8::Local<v8::Object> constructor) {
     Set(context, constructor,
-        "create", &CreateOnHeap<nu::Font, const std::string&, float,
-                                nu::Font::Weight, nu::Font::Style>,
+        "create", &Create,
         "default", &GetDefault);
   }
   static void BuildPrototype(v8::Local<v8::Context> context,
@@ -342,11 +382,29 @@ struct Type<nu::Font> {
         "getWeight", &nu::Font::GetWeight,
         "getStyle", &nu::Font::GetStyle);
   }
+  // Fonts are interned, equal requests get the same object.
+  static void Create(Arguments* args, const std::string& name, float size,
+                     nu::Font::Weight weight, nu::Font::Style style) {
+    scoped_refptr<nu::Font> font = nu::Font::Get(name, size, weight, style);
+    args->Return(font.get());
+  }
   static nu::Font* GetDefault() {
     return nu::App::GetCurrent()->GetDefaultFont();
   }
 };
 
+template<>
+struct Type<nu::Canvas::Pixels::Format> {
+  static constexpr const char* name = "yue.Canvas.Pixels.Format";
+  static v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                   nu::Canvas::Pixels::Format format) {
+    if (format == nu::Canvas::Pixels::Format::PremultipliedARGB)
+      return vb::ToV8(context, "premultiplied-argb");
+    else
+      return vb::ToV8(context, "argb");
+  }
+};
+
 template<>
 struct Type<nu::Canvas> {
   static constexpr const char* name = "yue.Canvas";
@@ -361,7 +419,38 @@ struct Type<nu::Canvas> {
     Set(context, templ,
         "getScaleFactor", &nu::Canvas::GetScaleFactor,
         "getPainter", &nu::Canvas::GetPainter,
-        "getSize", &nu::Canvas::GetSize);
+        "getSize", &nu::Canvas::GetSize,
+        "lockPixels", &LockPixels);
+  }
+  static void LockPixels(Arguments* args, v8::Local<v8::Function> callback) {
+    nu::Canvas* canvas;
+    if (!args->GetHolder(&canvas))
+      return;
+    v8::Isolate* isolate = args->isolate();
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+    nu::Canvas::Pixels pixels;
+    if (!canvas->LockPixels(&pixels)) {
+      ThrowTypeError(context, "Failed to lock pixels");
+      return;
+    }
+    // The ArrayBuffer views the pixels directly, and is detached after the
+    // callback so it can not be used after unlocking.
+    v8::Local<v8::ArrayBuffer> data = v8::ArrayBuffer::New(
+        isolate, pixels.data, pixels.stride * pixels.height);
+    v8::Local<v8::Object> obj = v8::Object::New(isolate);
+    Set(context, obj,
+        "data", data,
+        "width", pixels.width,
+        "height", pixels.height,
+        "stride", pixels.stride,
+        "format", pixels.format);
+    v8::Local<v8::Value> argv[] = { obj };
+    v8::TryCatch try_catch(isolate);
+    ignore_result(callback->Call(context, v8::Undefined(isolate), 1, argv));
+    data->Neuter();
+    canvas->UnlockPixels();
+    if (try_catch.HasCaught())
+      try_catch.ReThrow();
   }
 };
 
@@ -405,7 +494,10 @@ struct Type<nu::Image> {
   static void BuildConstructor(v8::Local<v8::Context> context,
                                v8::Local<v8::Object> constructor) {
     Set(context, constructor,
-        "createFromPath", &CreateOnHeap<nu::Image, const base::FilePath&>);
+        "createFromPath", &CreateFromPath,
+        "createFromBuffer", &CreateFromBuffer,
+        "loadAsync", &LoadAsync,
+        "getPlaceholder", &nu::Image::GetPlaceholder);
   }
   static void BuildPrototype(v8::Local<v8::Context> context,
                              v8::Local<v8::ObjectTemplate> templ) {
@@ -413,6 +505,124 @@ struct Type<nu::Image> {
         "getSize", &nu::Image::GetSize,
         "getScaleFactor", &nu::Image::GetScaleFactor);
   }
+  static nu::Image* CreateFromPath(Arguments* args,
+                                   const base::FilePath& path) {
+    nu::SizeF max_size;
+    args->GetNext(&max_size);
+    return new nu::Image(path, max_size);
+  }
+  static void CreateFromBuffer(Arguments* args, const nu::Buffer& buffer) {
+    float scale_factor = 1.f;
+    args->GetNext(&scale_factor);
+    scoped_refptr<nu::Image> image =
+        nu::Image::CreateFromBuffer(buffer, scale_factor);
+    args->Return(image.get());
+  }
+  static void LoadAsync(Arguments* args, const base::FilePath& path) {
+    // The max size is optional.
+    nu::SizeF max_size;
+    std::function<void(nu::Image*)> callback;
+    if (args->Length() > 2 && !args->GetNext(&max_size)) {
+      args->ThrowError("Size");
+      return;
+    }
+    if (!args->GetNext(&callback)) {
+      args->ThrowError("Function");
+      return;
+    }
+    nu::Image::LoadAsync(path, max_size,
+                         [callback](scoped_refptr<nu::Image> image) {
+      callback(image.get());
+    });
+  }
+};
+
+template<>
+struct Type<nu::ImageCache::Stats> {
+  static constexpr const char* name = "yue.ImageCache.Stats";
+  static v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                   const nu::ImageCache::Stats& stats) {
+    v8::Local<v8::Object> obj = v8::Object::New(context->GetIsolate());
+    Set(context, obj,
+        "hits", stats.hits,
+        "misses", stats.misses,
+        "evictions", stats.evictions,
+        "count", stats.count,
+        "memoryUsage", stats.memory_usage);
+    return obj;
+  }
+};
+
+template<>
+struct Type<nu::ImageCache> {
+  static constexpr const char* name = "yue.ImageCache";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor,
+        "setCapacity", &nu::ImageCache::SetCapacity,
+        "getCapacity", &nu::ImageCache::GetCapacity,
+        "getStats", &nu::ImageCache::GetStats,
+        "resetStats", &nu::ImageCache::ResetStats,
+        "clear", &nu::ImageCache::Clear);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+  }
+};
+
+template<>
+struct Type<nu::PixelOps::InstructionSet> {
+  static constexpr const char* name = "yue.PixelOps.InstructionSet";
+  static v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                   nu::PixelOps::InstructionSet set) {
+    if (set == nu::PixelOps::InstructionSet::AVX2)
+      return vb::ToV8(context, "avx2");
+    else if (set == nu::PixelOps::InstructionSet::SSE2)
+      return vb::ToV8(context, "sse2");
+    else
+      return vb::ToV8(context, "scalar");
+  }
+  static bool FromV8(v8::Local<v8::Context> context,
+                     v8::Local<v8::Value> value,
+                     nu::PixelOps::InstructionSet* out) {
+    std::string set;
+    if (!vb::FromV8(context, value, &set))
+      return false;
+    if (set == "avx2") {
+      *out = nu::PixelOps::InstructionSet::AVX2;
+      return true;
+    } else if (set == "sse2") {
+      *out = nu::PixelOps::InstructionSet::SSE2;
+      return true;
+    } else if (set == "scalar") {
+      *out = nu::PixelOps::InstructionSet::Scalar;
+      return true;
+    }
+    return false;
+  }
+};
+
+template<>
+struct Type<nu::PixelOps> {
+  static constexpr const char* name = "yue.PixelOps";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor,
+        "getInstructionSet", &nu::PixelOps::GetInstructionSet,
+        "setInstructionSet", &nu::PixelOps::SetInstructionSet,
+        "createCanvasFromImage", &CreateCanvasFromImage,
+        "boxBlur", &nu::PixelOps::BoxBlur,
+        "applyColorMatrix", &nu::PixelOps::ApplyColorMatrix,
+        "blend", &nu::PixelOps::Blend);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+  }
+  static void CreateCanvasFromImage(Arguments* args, nu::Image* image) {
+    scoped_refptr<nu::Canvas> canvas =
+        nu::PixelOps::CreateCanvasFromImage(image);
+    args->Return(canvas.get());
+  }
 };
 
 template<>
@@ -466,6 +676,28 @@ struct Type<nu::TextMetrics> {
   }
 };
 
+template<>
+struct Type<nu::Path> {
+  static constexpr const char* name = "yue.Path";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor, "create", &CreateOnHeap<nu::Path>);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "moveTo", &nu::Path::MoveTo,
+        "lineTo", &nu::Path::LineTo,
+        "bezierCurveTo", &nu::Path::BezierCurveTo,
+        "arc", &nu::Path::Arc,
+        "rect", &nu::Path::Rect,
+        "closePath", &nu::Path::ClosePath,
+        "translate", &nu::Path::Translate,
+        "rotate", &nu::Path::Rotate,
+        "scale", &nu::Path::Scale);
+  }
+};
+
 template<>
 struct Type<nu::Painter> {
   static constexpr const char* name = "yue.Painter";
@@ -495,10 +727,14 @@ struct Type<nu::Painter> {
         "setLineWidth", &nu::Painter::SetLineWidth,
         "stroke", &nu::Painter::Stroke,
         "fill", &nu::Painter::Fill,
+        "strokePath", &nu::Painter::StrokePath,
+        "fillPath", &nu::Painter::FillPath,
+        "clipPath", &nu::Painter::ClipPath,
         "strokeRect", &nu::Painter::StrokeRect,
         "fillRect", &nu::Painter::FillRect,
         "measureText", &nu::Painter::MeasureText,
-        "drawText", &nu::Painter::DrawText);
+        "drawText", &nu::Painter::DrawText,
+        "execute", &nu::Painter::Execute);
   }
 };
 
@@ -1285,6 +1521,22 @@ struct Type<nu::ProtocolStringJob> {
   }
 };
 
+template<>
+struct Type<nu::ProtocolBufferJob> {
+  using base = nu::ProtocolStringJob;
+  static constexpr const char* name = "yue.ProtocolBufferJob";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor,
+        "create", &CreateOnHeap<nu::ProtocolBufferJob,
+                                const std::string&,
+                                const nu::Buffer&>);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+  }
+};
+
 template<>
 struct Type<nu::ProtocolFileJob> {
   using base = nu::ProtocolJob;
@@ -1345,6 +1597,8 @@ struct Type<nu::Browser> {
         "reload", &nu::Browser::Reload,
         "stop", &nu::Browser::Stop,
         "setBindingName", &nu::Browser::SetBindingName,
+        "setBindingBatching", &nu::Browser::SetBindingBatching,
+        "isBindingBatching", &nu::Browser::IsBindingBatching,
         "addBinding", &AddBinding,
         "addRawBinding", &nu::Browser::AddRawBinding,
         "removeBinding", &nu::Browser::RemoveBinding);
@@ -1528,6 +1782,7 @@ struct Type<nu::TextEdit> {
         "canRedo", &nu::TextEdit::CanRedo,
         "undo", &nu::TextEdit::Undo,
         "canUndo", &nu::TextEdit::CanUndo,
+        "setUndoLimit", &nu::TextEdit::SetUndoLimit,
         "cut", &nu::TextEdit::Cut,
         "copy", &nu::TextEdit::Copy,
         "paste", &nu::TextEdit::Paste,
@@ -1538,12 +1793,85 @@ struct Type<nu::TextEdit> {
         "insertText", &nu::TextEdit::InsertText,
         "insertTextAt", &nu::TextEdit::InsertTextAt,
         "delete", &nu::TextEdit::Delete,
-        "deleteRange", &nu::TextEdit::DeleteRange);
+        "deleteRange", &nu::TextEdit::DeleteRange,
+        "appendText", &nu::TextEdit::AppendText,
+        "flushAppendedText", &nu::TextEdit::FlushAppendedText,
+        "setMaxLines", &nu::TextEdit::SetMaxLines,
+        "getMaxLines", &nu::TextEdit::GetMaxLines);
     SetProperty(context, templ,
                 "onTextChange", &nu::TextEdit::on_text_change);
   }
 };
 
+template<>
+struct Type<nu::Animation::Easing> {
+  static constexpr const char* name = "yue.Animation.Easing";
+  static v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                   nu::Animation::Easing easing) {
+    if (easing == nu::Animation::Easing::EaseIn)
+      return vb::ToV8(context, "ease-in");
+    else if (easing == nu::Animation::Easing::EaseOut)
+      return vb::ToV8(context, "ease-out");
+    else if (easing == nu::Animation::Easing::EaseInOut)
+      return vb::ToV8(context, "ease-in-out");
+    else
+      return vb::ToV8(context, "linear");
+  }
+  static bool FromV8(v8::Local<v8::Context> context,
+                     v8::Local<v8::Value> value,
+                     nu::Animation::Easing* out) {
+    std::string easing;
+    if (!vb::FromV8(context, value, &easing))
+      return false;
+    if (easing == "linear") {
+      *out = nu::Animation::Easing::Linear;
+      return true;
+    } else if (easing == "ease-in") {
+      *out = nu::Animation::Easing::EaseIn;
+      return true;
+    } else if (easing == "ease-out") {
+      *out = nu::Animation::Easing::EaseOut;
+      return true;
+    } else if (easing == "ease-in-out") {
+      *out = nu::Animation::Easing::EaseInOut;
+      return true;
+    } else {
+      return false;
+    }
+  }
+};
+
+template<>
+struct Type<nu::Animation> {
+  static constexpr const char* name = "yue.Animation";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor,
+        "create", &CreateOnHeap<nu::Animation, nu::View*>);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "setDuration", &nu::Animation::SetDuration,
+        "getDuration", &nu::Animation::GetDuration,
+        "setEasing", &nu::Animation::SetEasing,
+        "getEasing", &nu::Animation::GetEasing,
+        "animateStyle", &nu::Animation::AnimateStyle,
+        "animateBounds", &nu::Animation::AnimateBounds,
+        "animateColor", &nu::Animation::AnimateColor,
+        "animateBackgroundColor", &nu::Animation::AnimateBackgroundColor,
+        "animateValue", &nu::Animation::AnimateValue,
+        "getValue", &nu::Animation::GetValue,
+        "start", &nu::Animation::Start,
+        "stop", &nu::Animation::Stop,
+        "isRunning", &nu::Animation::IsRunning,
+        "getProgress", &nu::Animation::GetProgress,
+        "getView", &nu::Animation::GetView);
+    SetProperty(context, templ,
+                "onFinish", &nu::Animation::on_finish);
+  }
+};
+
 #if defined(OS_MACOSX)
 template<>
 struct Type<nu::Vibrant::Material> {
@@ -1694,8 +2022,11 @@ void Initialize(v8::Local<v8::Object> exports) {
           "App",               vb::Constructor<nu::App>(),
           "Font",              vb::Constructor<nu::Font>(),
           "Canvas",            vb::Constructor<nu::Canvas>(),
+          "Path",              vb::Constructor<nu::Path>(),
           "Color",             vb::Constructor<nu::Color>(),
           "Image",             vb::Constructor<nu::Image>(),
+          "ImageCache",        vb::Constructor<nu::ImageCache>(),
+          "PixelOps",          vb::Constructor<nu::PixelOps>(),
           "Painter",           vb::Constructor<nu::Painter>(),
           "Event",             vb::Constructor<nu::Event>(),
           "FileDialog",        vb::Constructor<nu::FileDialog>(),
@@ -1709,6 +2040,7 @@ void Initialize(v8::Local<v8::Object> exports) {
           "Container",         vb::Constructor<nu::Container>(),
           "Button",            vb::Constructor<nu::Button>(),
           "ProtocolStringJob", vb::Constructor<nu::ProtocolStringJob>(),
+          "ProtocolBufferJob", vb::Constructor<nu::ProtocolBufferJob>(),
           "ProtocolFileJob",   vb::Constructor<nu::ProtocolFileJob>(),
           "ProtocolAsarJob",   vb::Constructor<nu::ProtocolAsarJob>(),
           "Browser",           vb::Constructor<nu::Browser>(),
@@ -1718,6 +2050,8 @@ void Initialize(v8::Local<v8::Object> exports) {
           "Group",             vb::Constructor<nu::Group>(),
           "Scroll",            vb::Constructor<nu::Scroll>(),
           "TextEdit",          vb::Constructor<nu::TextEdit>(),
+          "Animation",         vb::Constructor<nu::Animation>(),
+          "ThreadPool",        vb::Constructor<nu::ThreadPool>(),
 #if defined(OS_MACOSX)
           "Toolbar",           vb::Constructor<nu::Toolbar>(),
           "Vibrant",           vb::Constructor<nu::Vibrant>(),
@@ -245,7 +245,8 @@ function convertModuleAndType(lang, node) {
   }
 
   let wrappedTypes = ['Painter', 'App', 'Lifetime', 'Signal']
-  let stringTypes = ['Accelerator', 'KeyboardCode', 'Font::Weight']
+  let stringTypes = ['Accelerator', 'KeyboardCode', 'Font::Weight',
+                     'PixelOps::InstructionSet']
   let integerTypes = ['Color']
   if (node.type == 'refcounted' || wrappedTypes.includes(node.name))
     node.type = 'Class'
@@ -80,6 +80,23 @@ struct Type<float> {
   }
 };
 
+template<>
+struct Type<double> {
+  static constexpr const char* name = "Number";
+  static inline v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                          double value) {
+    return v8::Number::New(context->GetIsolate(), value);
+  }
+  static bool FromV8(v8::Local<v8::Context> context,
+                     v8::Local<v8::Value> value,
+                     double* out) {
+    if (!value->IsNumber())
+      return false;
+    *out = value->NumberValue(context).ToChecked();
+    return true;
+  }
+};
+
 template<>
 struct Type<bool> {
   static constexpr const char* name = "Boolean";